@@ -0,0 +1,249 @@
+#include "recording_analysis.h"
+#include "async_logger.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// ============================================================================
+// Offline recording analyzer
+// ============================================================================
+// Triage for sessions recorded with test_handtracking_only --record: maps
+// each .htrec file, analyzes all of them chunk-parallel on every CPU (see
+// recording_analysis.h) and prints a compact report per session - sampling
+// gaps, per-hand dropouts and invalid joints, jitter and bone-length
+// consistency - followed by the throughput of the run. --joints adds a
+// table per hand with the statistics of every joint.
+// ============================================================================
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] <recording.htrec>..." << std::endl;
+    std::cout << "  --threads <n>       Worker threads (default: one per CPU)" << std::endl;
+    std::cout << "  --joints            Print the statistics of every joint" << std::endl;
+}
+
+static std::string FormatDuration(double seconds) {
+    uint64_t total = static_cast<uint64_t>(seconds);
+    std::ostringstream out;
+    out << std::setfill('0') << std::setw(2) << total / 3600 << ":" << std::setw(2) << total / 60 % 60 << ":"
+        << std::fixed << std::setprecision(3) << std::setw(6) << seconds - (total - total % 60);
+    return out.str();
+}
+
+static double Percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+// Change of the fitted bone length over the whole session, m
+static double BoneDrift(const TrendStats& bone, double durationSeconds) {
+    return bone.Slope() * durationSeconds;
+}
+
+struct WorstJoint {
+    int hand = -1;
+    uint32_t joint = 0;
+    double value = 0.0;
+
+    void Consider(int candidateHand, uint32_t candidateJoint, double candidateValue) {
+        if (candidateValue > value) {
+            hand = candidateHand;
+            joint = candidateJoint;
+            value = candidateValue;
+        }
+    }
+};
+
+static void PrintJointTable(const HandAnalysis& hand, int handIndex, double durationSeconds) {
+    std::cout << "  " << std::left << std::setw(24) << (std::string(HandName(handIndex)) + " joint") << std::right
+              << std::setw(8) << "PosInv" << std::setw(8) << "OriInv"
+              << std::setw(11) << "Jitter rms" << std::setw(9) << "max"
+              << std::setw(11) << "Bone mean" << std::setw(8) << "sd" << std::setw(8) << "range"
+              << std::setw(8) << "drift" << std::endl;
+    for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+        const JointAnalysis& joint = hand.joints[j];
+        std::cout << "  " << std::left << std::setw(24) << JointName(j) << std::right << std::fixed
+                  << std::setprecision(2)
+                  << std::setw(7) << Percent(joint.positionInvalid, hand.activeFrames) << "%"
+                  << std::setw(7) << Percent(joint.orientationInvalid, hand.activeFrames) << "%"
+                  << std::setprecision(3)
+                  << std::setw(11) << joint.JitterRms() * 1000.0 << std::setw(9) << joint.JitterMax() * 1000.0;
+        if (joint.bone.count > 0) {
+            std::cout << std::setprecision(2)
+                      << std::setw(11) << joint.bone.meanY * 1000.0 << std::setw(8) << joint.bone.StdDev() * 1000.0
+                      << std::setw(8) << (joint.bone.maxY - joint.bone.minY) * 1000.0
+                      << std::setw(8) << BoneDrift(joint.bone, durationSeconds) * 1000.0;
+        } else {
+            std::cout << std::setw(11) << "-";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
+
+static void PrintSession(const std::string& path, const RecordingReader& reader, const SessionAnalysis& session,
+                         bool printJoints) {
+    std::cout << std::endl << "=== " << path << " ===" << std::endl;
+    if (session.frames == 0) {
+        std::cout << "  No frames" << std::endl;
+        return;
+    }
+    const double targetHz = reader.Header()->sampleRateHz;
+    const double durationSeconds =
+        (reader.Frame(reader.FrameCount() - 1)->sampleTimeNs - reader.Frame(0)->sampleTimeNs) * 1e-9;
+    std::cout << "  " << session.frames << " frames over " << FormatDuration(durationSeconds) << std::fixed
+              << std::setprecision(1) << ", target " << targetHz << " Hz"
+              << ", achieved " << (durationSeconds > 0.0 ? (session.frames - 1) / durationSeconds : 0.0) << " Hz"
+              << std::defaultfloat << std::endl;
+    std::cout << "  ";
+    session.intervals.Print(std::cout, "Sample interval", "ms", 1e6);
+    std::cout << "  " << session.gaps << " gaps over " << std::fixed << std::setprecision(1) << ANALYSIS_GAP_FACTOR
+              << " periods (" << std::setprecision(3) << session.gapNs * 1e-9 << " s missing), "
+              << session.recorderDrops << " frames dropped by the recorder" << std::defaultfloat << std::endl;
+
+    std::cout << "  " << std::left << std::setw(6) << "Hand" << std::right
+              << std::setw(8) << "Active" << std::setw(10) << "Failures" << std::setw(10) << "Dropouts"
+              << std::setw(11) << "Lost (s)" << std::setw(13) << "Longest (s)"
+              << std::setw(9) << "PosInv" << std::setw(9) << "OriInv"
+              << std::setw(12) << "Jitter (mm)" << std::setw(13) << "Bone sd (mm)" << std::endl;
+    WorstJoint worstJitter;
+    WorstJoint worstInvalid;
+    WorstJoint worstSpread;
+    WorstJoint worstDrift;
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const HandAnalysis& data = session.hands[hand];
+        uint64_t positionInvalid = 0;
+        uint64_t orientationInvalid = 0;
+        uint64_t jitterSamples = 0;
+        double jitterSumSq = 0.0;
+        double boneSpreadSum = 0.0;
+        int bones = 0;
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const JointAnalysis& joint = data.joints[j];
+            positionInvalid += joint.positionInvalid;
+            orientationInvalid += joint.orientationInvalid;
+            jitterSamples += joint.jitterSamples;
+            jitterSumSq += joint.jitterSumSq;
+            worstJitter.Consider(hand, j, joint.JitterRms());
+            worstInvalid.Consider(hand, j, Percent(joint.positionInvalid, data.activeFrames));
+            if (joint.bone.count > 1) {
+                boneSpreadSum += joint.bone.StdDev();
+                bones++;
+                worstSpread.Consider(hand, j, joint.bone.StdDev());
+                worstDrift.Consider(hand, j, std::fabs(BoneDrift(joint.bone, durationSeconds)));
+            }
+        }
+        const uint64_t jointFrames = data.activeFrames * XR_HAND_JOINT_COUNT_EXT;
+        std::cout << "  " << std::left << std::setw(6) << HandName(hand) << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(7) << Percent(data.activeFrames, session.frames) << "%"
+                  << std::setw(10) << data.locateFailures << std::setw(10) << data.dropouts.Count()
+                  << std::setprecision(3) << std::setw(11) << data.dropoutNs * 1e-9
+                  << std::setw(13) << data.dropouts.Max() * 1e-9
+                  << std::setprecision(2) << std::setw(8) << Percent(positionInvalid, jointFrames) << "%"
+                  << std::setw(8) << Percent(orientationInvalid, jointFrames) << "%"
+                  << std::setprecision(3) << std::setw(12)
+                  << (jitterSamples ? std::sqrt(jitterSumSq / jitterSamples) * 1000.0 : 0.0)
+                  << std::setw(13) << (bones ? boneSpreadSum / bones * 1000.0 : 0.0)
+                  << std::defaultfloat << std::endl;
+    }
+
+    // The joints to look at first
+    std::cout << "  Worst:" << std::fixed << std::setprecision(3);
+    if (worstJitter.hand >= 0) {
+        std::cout << " jitter " << HandName(worstJitter.hand) << " " << JointName(worstJitter.joint) << " "
+                  << worstJitter.value * 1000.0 << " mm rms;";
+    }
+    if (worstInvalid.hand >= 0) {
+        std::cout << " invalid " << HandName(worstInvalid.hand) << " " << JointName(worstInvalid.joint) << " "
+                  << std::setprecision(2) << worstInvalid.value << "%;" << std::setprecision(3);
+    }
+    if (worstSpread.hand >= 0) {
+        std::cout << " bone sd " << HandName(worstSpread.hand) << " " << JointName(worstSpread.joint) << " "
+                  << worstSpread.value * 1000.0 << " mm;";
+    }
+    if (worstDrift.hand >= 0) {
+        std::cout << " bone drift " << HandName(worstDrift.hand) << " " << JointName(worstDrift.joint) << " "
+                  << worstDrift.value * 1000.0 << " mm";
+    }
+    if (worstJitter.hand < 0 && worstInvalid.hand < 0 && worstSpread.hand < 0) {
+        std::cout << " -";
+    }
+    std::cout << std::defaultfloat << std::endl;
+
+    if (printJoints) {
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            std::cout << std::endl;
+            PrintJointTable(session.hands[hand], hand, durationSeconds);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = 0;
+    bool printJoints = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) {
+            if (!ParseInteger(argv[++i], threads) || threads == 0) {
+                std::cerr << "--threads must be a positive number" << std::endl;
+                return -1;
+            }
+        } else if (arg == "--joints") {
+            printJoints = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            paths.push_back(arg);
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (paths.empty()) {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    // A file that cannot be read is reported and left out
+    std::vector<std::unique_ptr<RecordingReader>> readers;
+    std::vector<const RecordingReader*> sessions;
+    std::vector<std::string> sessionPaths;
+    uint64_t totalFrames = 0;
+    for (const std::string& path : paths) {
+        std::unique_ptr<RecordingReader> reader(new RecordingReader());
+        if (!reader->Open(path)) {
+            continue;
+        }
+        totalFrames += reader->FrameCount();
+        sessions.push_back(reader.get());
+        sessionPaths.push_back(path);
+        readers.push_back(std::move(reader));
+    }
+    if (sessions.empty()) {
+        return -1;
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SessionAnalysis> results;
+    AnalyzeRecordings(sessions, threads, results);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        PrintSession(sessionPaths[i], *sessions[i], results[i], printJoints);
+    }
+
+    const double gigabytes = totalFrames * static_cast<double>(sizeof(RecordedFrame)) / 1e9;
+    std::cout << std::endl << "Analyzed " << sessions.size() << " session(s), " << totalFrames << " frames ("
+              << std::fixed << std::setprecision(2) << gigabytes << " GB) in " << std::setprecision(3) << seconds
+              << " s on " << threads << " threads: " << std::setprecision(1)
+              << (seconds > 0.0 ? totalFrames / seconds / 1e6 : 0.0) << " M frames/s, "
+              << std::setprecision(2) << (seconds > 0.0 ? gigabytes / seconds : 0.0) << " GB/s" << std::endl;
+    return 0;
+}
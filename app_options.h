@@ -0,0 +1,225 @@
+#pragma once
+
+#include "hand_tracking_app.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+// Command-line options of the tracking app. libhandtrack takes the same
+// options in ht_create(), so embedding applications configure tracking
+// exactly like the test app.
+
+inline void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --core <host[:port],...> Manus Core(s) to connect to; repeatable, first to answer wins" << std::endl;
+    std::cout << "                      (default " << TARGET_MANUS_CORE_IP << ")" << std::endl;
+    std::cout << "  --core-port <n>     TCP port probed on targets given without one (default " << DEFAULT_MANUS_CORE_PROBE_PORT << ")" << std::endl;
+    std::cout << "  --core-probe-ms <ms> Probe timeout, 0 = connect to the first target unprobed (default " << DEFAULT_CORE_PROBE_TIMEOUT_MS << ")" << std::endl;
+    std::cout << "  --rate <hz>         Sampling rate, 0 = free-running (default " << DEFAULT_SAMPLE_RATE_HZ << ")" << std::endl;
+    std::cout << "  --spin-us <us>      Busy-wait tail before each deadline (default " << DEFAULT_SPIN_TAIL_US << ")" << std::endl;
+    std::cout << "  --predict-ms <ms>   Locate joints this far past the sample time (default 0)" << std::endl;
+    std::cout << "  --filter <mode>     Joint pose filter: off (default), one-euro or kalman" << std::endl;
+    std::cout << "  --filter-param <group>.<name>=<value>" << std::endl;
+    std::cout << "                      Tune the filter for palm, thumb, index, middle, ring, little or all:" << std::endl;
+    std::cout << "                      min-cutoff, beta, d-cutoff, lag-compensation (one-euro)," << std::endl;
+    std::cout << "                      measurement-noise, process-noise (kalman), prediction-ms (both)" << std::endl;
+    std::cout << "  --gestures          Detect pinch, grab and point and log them as events" << std::endl;
+    std::cout << "  --gesture-param <name>=<value>" << std::endl;
+    std::cout << "                      pinch-start, pinch-end (m), grab-start, grab-end, point-extended," << std::endl;
+    std::cout << "                      point-release, point-folded, point-unfold (rad of curl), debounce-ms" << std::endl;
+    std::cout << "  --gesture-events <host:port> Send gesture events over UDP (implies --gestures)" << std::endl;
+    std::cout << "  --metrics <[host:]port> Serve Prometheus metrics at /metrics (host default 127.0.0.1," << std::endl;
+    std::cout << "                      port e.g. " << DEFAULT_METRICS_PORT << ")" << std::endl;
+    std::cout << "  --realtime          Pin the sampler to a CPU, run it SCHED_FIFO and lock memory" << std::endl;
+    std::cout << "  --rt-cpu <n>        CPU for --realtime (default: the last allowed one)" << std::endl;
+    std::cout << "  --rt-priority <1-99> SCHED_FIFO priority for --realtime (default " << DEFAULT_REALTIME_PRIORITY << ")" << std::endl;
+    std::cout << "  --ring-size <n>     Frames buffered per consumer (default " << DEFAULT_FRAME_RING_CAPACITY << ")" << std::endl;
+    std::cout << "  --overflow <policy> drop-oldest (default) or drop-newest when a consumer falls behind" << std::endl;
+    std::cout << "  --record <file>     Record every frame to a binary .htrec file" << std::endl;
+    std::cout << "  --replay <file>     Serve frames from a recording instead of the OpenXR runtime" << std::endl;
+    std::cout << "  --replay-fast       Advance one recorded frame per sample (combine with --rate 0)" << std::endl;
+    std::cout << "  --replay-loop       Restart the replay at the end of the recording" << std::endl;
+    std::cout << "  --synthetic         Serve procedural hand data instead of the OpenXR runtime" << std::endl;
+    std::cout << "  --verbosity <0-3>   Tracking log: 0 failures, 1 +hand state, 2 +palm, 3 +key joints (default 3)" << std::endl;
+    std::cout << "  --log-file <file>   Write the tracking log to a file instead of stdout" << std::endl;
+    std::cout << "  --shm <name>        Publish frames to POSIX shared memory (e.g. " << DEFAULT_SHARED_FRAME_NAME << ")" << std::endl;
+    std::cout << "  --stream <host:port> Stream compressed frames over UDP (port default " << DEFAULT_STREAM_PORT << ")" << std::endl;
+    std::cout << "  --stream-keyframe <n> Frames between stream keyframes (default " << DEFAULT_STREAM_KEYFRAME_INTERVAL << ")" << std::endl;
+    std::cout << "  --help              Show this help" << std::endl;
+}
+
+// Returns false if the options are invalid or --help printed the usage;
+// helpShown tells the two apart. --help only counts once every other
+// option has parsed, so an invalid option is reported as such.
+inline bool ParseArguments(int argc, const char* const* argv, AppConfig& config, bool& helpShown) {
+    helpShown = false;
+    const char* program = argc > 0 ? argv[0] : "handtrack";
+    std::vector<std::string> coreTargets;
+    bool helpRequested = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--core" && hasValue) {
+            for (const std::string& target : ParseCoreTargets(argv[++i])) {
+                coreTargets.push_back(target);
+            }
+        } else if (arg == "--core-port" && hasValue) {
+            int port = 0;
+            if (!ParseInteger(argv[++i], port) || port <= 0 || port > 65535) {
+                std::cerr << "Invalid core port: " << argv[i] << std::endl;
+                return false;
+            }
+            config.coreProbePort = static_cast<uint16_t>(port);
+        } else if (arg == "--core-probe-ms" && hasValue) {
+            if (!ParseInteger(argv[++i], config.coreProbeTimeoutMs)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--rate" && hasValue) {
+            if (!ParseNumber(argv[++i], config.sampleRateHz)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--spin-us" && hasValue) {
+            if (!ParseInteger(argv[++i], config.spinTailUs)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--predict-ms" && hasValue) {
+            double offsetMs = 0.0;
+            if (!ParseNumber(argv[++i], offsetMs)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+            if (offsetMs < -MAX_PREDICTION_OFFSET_MS || offsetMs > MAX_PREDICTION_OFFSET_MS) {
+                std::cerr << "Prediction offset must be within +/-" << MAX_PREDICTION_OFFSET_MS << " ms" << std::endl;
+                return false;
+            }
+            config.predictionOffsetNs = static_cast<int64_t>(offsetMs * 1e6);
+        } else if (arg == "--filter" && hasValue) {
+            if (!ParseFilterMode(argv[++i], config.filterMode)) {
+                std::cerr << "Unknown filter: " << argv[i] << " (expected off, one-euro or kalman)" << std::endl;
+                return false;
+            }
+        } else if (arg == "--filter-param" && hasValue) {
+            if (!ParseFilterParam(argv[++i], config.filterParams)) {
+                std::cerr << "Invalid filter parameter: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--ring-size" && hasValue) {
+            if (!ParseInteger(argv[++i], config.frameRingCapacity)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--record" && hasValue) {
+            config.recordPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            config.replayPath = argv[++i];
+        } else if (arg == "--replay-fast") {
+            config.replayFast = true;
+        } else if (arg == "--replay-loop") {
+            config.replayLoop = true;
+        } else if (arg == "--synthetic") {
+            config.synthetic = true;
+        } else if (arg == "--verbosity" && hasValue) {
+            int level = 0;
+            if (!ParseInteger(argv[++i], level) || level < 0 || level > 3) {
+                std::cerr << "Verbosity must be between 0 and 3" << std::endl;
+                return false;
+            }
+            config.verbosity = static_cast<LogLevel>(level);
+        } else if (arg == "--log-file" && hasValue) {
+            config.logPath = argv[++i];
+        } else if (arg == "--shm" && hasValue) {
+            config.shmName = argv[++i];
+            if (config.shmName.empty() || config.shmName[0] != '/') {
+                config.shmName = "/" + config.shmName;
+            }
+        } else if (arg == "--stream" && hasValue) {
+            config.streamDestination = argv[++i];
+        } else if (arg == "--gestures") {
+            config.gestures = true;
+        } else if (arg == "--gesture-param" && hasValue) {
+            if (!ParseGestureParam(argv[++i], config.gestureThresholds)) {
+                std::cerr << "Invalid gesture parameter: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--gesture-events" && hasValue) {
+            config.gestureDestination = argv[++i];
+            config.gestures = true;
+        } else if (arg == "--realtime") {
+            config.realtime.enabled = true;
+        } else if (arg == "--rt-cpu" && hasValue) {
+            if (!ParseInteger(argv[++i], config.realtime.cpu)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+            config.realtime.enabled = true;
+        } else if (arg == "--rt-priority" && hasValue) {
+            if (!ParseInteger(argv[++i], config.realtime.priority)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+            config.realtime.enabled = true;
+        } else if (arg == "--metrics" && hasValue) {
+            config.metricsAddress = argv[++i];
+        } else if (arg == "--stream-keyframe" && hasValue) {
+            if (!ParseInteger(argv[++i], config.streamKeyframeInterval)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (arg == "--overflow" && hasValue) {
+            std::string policy = argv[++i];
+            if (policy == "drop-oldest") {
+                config.overflowPolicy = OverflowPolicy::DropOldest;
+            } else if (policy == "drop-newest") {
+                config.overflowPolicy = OverflowPolicy::DropNewest;
+            } else {
+                std::cerr << "Unknown overflow policy: " << policy << std::endl;
+                return false;
+            }
+        } else if (arg == "--help" || arg == "-h") {
+            helpRequested = true;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            PrintUsage(program);
+            return false;
+        }
+    }
+    if (helpRequested) {
+        PrintUsage(program);
+        helpShown = true;
+        return false;
+    }
+    
+    if (!coreTargets.empty()) {
+        config.coreTargets = coreTargets;
+    }
+    if (config.coreProbeTimeoutMs < 0) {
+        std::cerr << "Core probe timeout must not be negative" << std::endl;
+        return false;
+    }
+    if (config.sampleRateHz < 0.0 || config.spinTailUs < 0) {
+        std::cerr << "Rate and spin tail must not be negative" << std::endl;
+        return false;
+    }
+    if (!ValidateRealtimeConfig(config.realtime, config.sampleRateHz, std::cerr)) {
+        return false;
+    }
+    if (config.streamKeyframeInterval == 0) {
+        std::cerr << "Stream keyframe interval must be at least 1" << std::endl;
+        return false;
+    }
+    if (!ValidateGestureThresholds(config.gestureThresholds)) {
+        std::cerr << "Gesture end thresholds must not be stricter than the start thresholds" << std::endl;
+        return false;
+    }
+    if (config.frameRingCapacity == 0) {
+        std::cerr << "Ring size must be at least 1" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "spsc_ring.h"
+#include "hand_frame.h"
+#include "gesture_event.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// How much the tracking loop logs (--verbosity)
+enum class LogLevel : uint8_t {
+    Errors = 0,  // locate failures only
+    Events = 1,  // + hands becoming active/inactive
+    Palm = 2,    // + periodic palm positions
+    Joints = 3   // + periodic key joint dumps
+};
+
+enum class LogEvent : uint16_t {
+    HandActive,
+    HandInactive,
+    LocateFailed,    // intArg = XrResult
+    PalmPosition,    // values = x, y, z, linear velocity; intArg = VelocitySource (0 = no velocity)
+    JointDumpBegin,  // intArg = joint count
+    JointDump,       // joint, intArg = location flags, values = position, orientation, radius
+    JointDumpEnd,
+    Gesture          // joint = GestureType, intArg = debounce delay (ns), values = value, position
+};
+
+// Compact binary log record. Producers fill in raw values only; all
+// formatting happens on the logger thread.
+struct LogRecord {
+    LogEvent event;
+    uint8_t hand;
+    uint8_t joint;
+    uint32_t reserved;
+    uint64_t frameIndex;
+    int64_t intArg;
+    float values[8];
+};
+
+static_assert(sizeof(LogRecord) == 56, "LogRecord layout changed");
+
+inline const char* JointName(uint32_t joint) {
+    static const char* const names[XR_HAND_JOINT_COUNT_EXT] = {
+        "Palm", "Wrist",
+        "Thumb Metacarpal", "Thumb Proximal", "Thumb Distal", "Thumb Tip",
+        "Index Metacarpal", "Index Proximal", "Index Intermediate", "Index Distal", "Index Tip",
+        "Middle Metacarpal", "Middle Proximal", "Middle Intermediate", "Middle Distal", "Middle Tip",
+        "Ring Metacarpal", "Ring Proximal", "Ring Intermediate", "Ring Distal", "Ring Tip",
+        "Little Metacarpal", "Little Proximal", "Little Intermediate", "Little Distal", "Little Tip"};
+    return joint < XR_HAND_JOINT_COUNT_EXT ? names[joint] : "Unknown";
+}
+
+// Asynchronous logger. Each producing thread gets its own preallocated
+// SPSC channel, so logging from a hot thread is one fixed-size copy with
+// no locks, allocation or formatting. A background thread drains all
+// channels, formats the records and writes them in batches with a single
+// write() per batch. A full channel drops the new record and counts it.
+class AsyncLogger {
+public:
+    using Channel = SpscRing<LogRecord>;
+
+    explicit AsyncLogger(LogLevel level) : m_level(level) {}
+
+    ~AsyncLogger() {
+        Stop();
+        if (m_ownsFd && m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    // Writes to the given file instead of stdout. Call before Start().
+    bool OpenFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::fprintf(stderr, "Failed to open log file %s: %s\n", path.c_str(), std::strerror(errno));
+            return false;
+        }
+        m_fd = fd;
+        m_ownsFd = true;
+        return true;
+    }
+
+    bool IsEnabled(LogLevel level) const { return level <= m_level; }
+
+    // Channels must be created before Start()
+    Channel* CreateChannel(size_t capacity) {
+        m_channels.push_back(std::make_unique<Channel>(capacity, OverflowPolicy::DropNewest));
+        return m_channels.back().get();
+    }
+
+    void Start() {
+        if (m_running.exchange(true)) {
+            return;
+        }
+        m_thread = std::thread(&AsyncLogger::Loop, this);
+    }
+
+    // Drains and writes everything still queued
+    void Stop() {
+        m_running.store(false);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    uint64_t GetWrittenCount() const { return m_written.load(std::memory_order_relaxed); }
+
+    uint64_t GetDroppedCount() const {
+        uint64_t dropped = 0;
+        for (const auto& channel : m_channels) {
+            dropped += channel->GetDroppedCount();
+        }
+        return dropped;
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t MAX_RECORD_TEXT = 512;
+    static constexpr std::chrono::milliseconds IDLE_PERIOD{5};
+
+    LogLevel m_level;
+    int m_fd = STDOUT_FILENO;
+    bool m_ownsFd = false;
+    std::vector<std::unique_ptr<Channel>> m_channels;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_written{0};
+    std::thread m_thread;
+
+    char m_buffer[BUFFER_SIZE];
+    size_t m_used = 0;
+
+    void Loop() {
+        LogRecord record;
+        while (true) {
+            bool running = m_running.load();
+            bool any = false;
+            for (const auto& channel : m_channels) {
+                while (channel->Pop(record)) {
+                    any = true;
+                    if (BUFFER_SIZE - m_used < MAX_RECORD_TEXT) {
+                        WriteBuffer();
+                    }
+                    m_used += Format(record, m_buffer + m_used, BUFFER_SIZE - m_used);
+                    m_written.store(m_written.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+            }
+            WriteBuffer();
+            if (!running) {
+                break;
+            }
+            if (!any) {
+                std::this_thread::sleep_for(IDLE_PERIOD);
+            }
+        }
+    }
+
+    void WriteBuffer() {
+        size_t offset = 0;
+        while (offset < m_used) {
+            ssize_t written = ::write(m_fd, m_buffer + offset, m_used - offset);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;  // nowhere to report it; drop the batch
+            }
+            offset += static_cast<size_t>(written);
+        }
+        m_used = 0;
+    }
+
+    static size_t Format(const LogRecord& r, char* out, size_t size) {
+        const char* hand = HandName(r.hand);
+        const unsigned long long frame = static_cast<unsigned long long>(r.frameIndex);
+        int length = 0;
+
+        switch (r.event) {
+        case LogEvent::HandActive:
+            length = std::snprintf(out, size, "[Frame %llu] %s hand became ACTIVE\n", frame, hand);
+            break;
+        case LogEvent::HandInactive:
+            length = std::snprintf(out, size, "[Frame %llu] %s hand became INACTIVE\n", frame, hand);
+            break;
+        case LogEvent::LocateFailed:
+            length = std::snprintf(out, size, "[Frame %llu] %s hand tracking FAILED with result: %lld\n",
+                                   frame, hand, static_cast<long long>(r.intArg));
+            break;
+        case LogEvent::PalmPosition:
+            if (r.intArg != static_cast<int64_t>(VelocitySource::None)) {
+                length = std::snprintf(out, size, "[Frame %llu] %s palm: (%.3f, %.3f, %.3f) velocity: (%.3f, %.3f, %.3f) m/s%s\n",
+                                       frame, hand, r.values[0], r.values[1], r.values[2],
+                                       r.values[3], r.values[4], r.values[5],
+                                       r.intArg == static_cast<int64_t>(VelocitySource::Estimated) ? " (estimated)" : "");
+            } else {
+                length = std::snprintf(out, size, "[Frame %llu] %s palm: (%.3f, %.3f, %.3f)\n",
+                                       frame, hand, r.values[0], r.values[1], r.values[2]);
+            }
+            break;
+        case LogEvent::JointDumpBegin:
+            length = std::snprintf(out, size, "\n[Frame %llu] %s HAND TRACKING DATA:\n  Active: YES, Joint Count: %lld\n",
+                                   frame, hand, static_cast<long long>(r.intArg));
+            break;
+        case LogEvent::JointDump: {
+            const uint64_t flags = static_cast<uint64_t>(r.intArg);
+            char position[64];
+            char orientation[80];
+            if (flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
+                std::snprintf(position, sizeof(position), "pos(%.3f, %.3f, %.3f)",
+                              r.values[0], r.values[1], r.values[2]);
+            } else {
+                std::snprintf(position, sizeof(position), "pos(INVALID)");
+            }
+            if (flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) {
+                std::snprintf(orientation, sizeof(orientation), "rot(%.3f, %.3f, %.3f, %.3f)",
+                              r.values[3], r.values[4], r.values[5], r.values[6]);
+            } else {
+                std::snprintf(orientation, sizeof(orientation), "rot(INVALID)");
+            }
+            length = std::snprintf(out, size, "    %s: %s %s radius(%.3f)\n",
+                                   JointName(r.joint), position, orientation, r.values[7]);
+            break;
+        }
+        case LogEvent::JointDumpEnd:
+            length = std::snprintf(out, size, "\n");
+            break;
+        case LogEvent::Gesture:
+            length = std::snprintf(out, size, "[Frame %llu] %s hand gesture: %s (value %.3f) at (%.3f, %.3f, %.3f), debounced %.1f ms\n",
+                                   frame, hand, GestureTypeName(static_cast<GestureType>(r.joint)), r.values[0],
+                                   r.values[1], r.values[2], r.values[3], r.intArg / 1e6);
+            break;
+        }
+
+        if (length < 0) {
+            return 0;
+        }
+        return std::min(static_cast<size_t>(length), size - 1);
+    }
+};
+
+// Producer-side helpers
+inline LogRecord MakeLogRecord(LogEvent event, uint64_t frameIndex, int hand) {
+    LogRecord record;
+    record.event = event;
+    record.hand = static_cast<uint8_t>(hand);
+    record.joint = 0;
+    record.reserved = 0;
+    record.frameIndex = frameIndex;
+    record.intArg = 0;
+    std::memset(record.values, 0, sizeof(record.values));
+    return record;
+}
@@ -0,0 +1,279 @@
+#include "hand_tracking_app.h"
+#include "latency_histogram.h"
+#include "sampling_scheduler.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <ctime>
+
+// ============================================================================
+// Per-frame path benchmark
+// ============================================================================
+// Drives the same code the sampler thread runs, one frame at a
+// time on this thread, and reports latency histograms for:
+//   - each xrLocateHandJointsEXT call
+//   - the sampling step (both hands)
+//   - the ring hand-off (push + pop)
+//   - capture to delivery: the frame's sample time to the ring pop
+//   - queuing the frame's log records (formatted and written to /dev/null
+//     by the logger thread by default)
+//   - the whole frame, plus thread CPU time and heap allocations per frame
+//
+// By default it runs against the synthetic stand-in so results are
+// comparable run-to-run on any machine; --openxr measures the real runtime
+// and Manus layer, --replay a recorded session.
+// ============================================================================
+
+// Heap allocation counter (all threads)
+static std::atomic<uint64_t> g_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+struct BenchmarkOptions {
+    uint64_t frames = 20000;
+    uint64_t warmupFrames = 1000;
+    double rateHz = 0.0;       // 0 = back-to-back
+    bool keepConsole = false;  // write the tracking log to the terminal
+    bool openxr = false;
+};
+
+static uint64_t ThreadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --frames <n>        Measured frames (default 20000)" << std::endl;
+    std::cout << "  --warmup <n>        Unmeasured frames before measuring (default 1000)" << std::endl;
+    std::cout << "  --rate <hz>         Pace frames like the sampler, 0 = back-to-back (default 0)" << std::endl;
+    std::cout << "  --openxr            Measure the OpenXR runtime and Manus layer instead of synthetic data" << std::endl;
+    std::cout << "  --replay <file>     Measure with frames from a recording" << std::endl;
+    std::cout << "  --console           Keep the tracking log on the terminal instead of /dev/null" << std::endl;
+    std::cout << "  --filter <mode>     Include the joint filter in the sample step: one-euro or kalman" << std::endl;
+    std::cout << "  --gestures          Include gesture detection in the sample step" << std::endl;
+    std::cout << "  --metrics           Include the metrics counters in the sample step" << std::endl;
+    std::cout << "  --realtime          Run the measured thread like the --realtime sampler (pinned, SCHED_FIFO," << std::endl;
+    std::cout << "                      locked memory, needs --rate); --rt-cpu <n> and --rt-priority <n> as in the app" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    AppConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            if (!ParseInteger(argv[++i], options.frames)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--warmup" && hasValue) {
+            if (!ParseInteger(argv[++i], options.warmupFrames)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--rate" && hasValue) {
+            if (!ParseNumber(argv[++i], options.rateHz)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--openxr") {
+            options.openxr = true;
+        } else if (arg == "--replay" && hasValue) {
+            config.replayPath = argv[++i];
+            config.replayFast = true;
+            config.replayLoop = true;
+        } else if (arg == "--console") {
+            options.keepConsole = true;
+        } else if (arg == "--filter" && hasValue) {
+            if (!ParseFilterMode(argv[++i], config.filterMode)) {
+                PrintUsage(argv[0]);
+                return -1;
+            }
+        } else if (arg == "--gestures") {
+            config.gestures = true;
+        } else if (arg == "--realtime") {
+            config.realtime.enabled = true;
+        } else if (arg == "--rt-cpu" && hasValue) {
+            if (!ParseInteger(argv[++i], config.realtime.cpu)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+            config.realtime.enabled = true;
+        } else if (arg == "--rt-priority" && hasValue) {
+            if (!ParseInteger(argv[++i], config.realtime.priority)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+            config.realtime.enabled = true;
+        } else if (arg == "--metrics") {
+            // Enables the counters; the endpoint itself only starts in Run()
+            config.metricsAddress = std::to_string(DEFAULT_METRICS_PORT);
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (options.frames == 0) {
+        std::cerr << "--frames must be at least 1" << std::endl;
+        return -1;
+    }
+    if (options.rateHz < 0.0) {
+        std::cerr << "--rate must not be negative" << std::endl;
+        return -1;
+    }
+    if (!ValidateRealtimeConfig(config.realtime, options.rateHz, std::cerr)) {
+        return -1;
+    }
+    config.synthetic = !options.openxr && config.replayPath.empty();
+    config.sampleRateHz = options.rateHz;
+    if (!options.keepConsole) {
+        config.logPath = "/dev/null";
+    }
+
+    HandTrackingOnlyApp app(config);
+    if (!app.Initialize()) {
+        std::cerr << "Failed to initialize hand tracking app" << std::endl;
+        return -1;
+    }
+
+    LatencyHistogram locateCall;
+    LatencyHistogram sampleStep;
+    LatencyHistogram ringHandoff;
+    LatencyHistogram captureToDelivery;
+    LatencyHistogram logStep;
+    LatencyHistogram framePath;
+    LatencyHistogram frameCpu;
+    LatencyHistogram frameAllocations;
+    LatencyHistogram wakeLateness;
+
+    SpscRing<HandFrame> ring(16, OverflowPolicy::DropOldest);
+    SamplingScheduler scheduler(options.rateHz);
+    HandFrame frame;
+    HandFrame received;
+
+    // Same setup as the app's sampler thread, applied to this one
+    const ThreadScheduling originalScheduling = SaveCurrentThreadScheduling();
+    if (config.realtime.enabled) {
+        int memoryLockError = LockProcessMemory();
+        PrintRealtimeStatus(std::cout, ApplyRealtimeToCurrentThread(config.realtime), memoryLockError);
+    }
+
+    const uint64_t totalFrames = options.warmupFrames + options.frames;
+    auto runStart = std::chrono::steady_clock::now();
+    uint64_t runCpuStart = ThreadCpuNs();
+
+    for (uint64_t i = 0; i < totalFrames; ++i) {
+        scheduler.WaitForNextTick();
+        bool measure = i >= options.warmupFrames;
+        if (measure && options.rateHz > 0.0) {
+            wakeLateness.Record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(scheduler.GetLastLateness()).count()));
+        }
+        if (measure && i == options.warmupFrames) {
+            runStart = std::chrono::steady_clock::now();
+            runCpuStart = ThreadCpuNs();
+        }
+
+        uint64_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+        uint64_t cpuBefore = ThreadCpuNs();
+        auto t0 = std::chrono::steady_clock::now();
+
+        frame.frameIndex = i;
+        app.LocateHands(frame, measure ? &locateCall : nullptr);
+        app.FilterFrame(frame);
+        app.DetectGestures(frame);
+        auto t1 = std::chrono::steady_clock::now();
+
+        ring.Push(frame);
+        ring.Pop(received);
+        auto t2 = std::chrono::steady_clock::now();
+
+        app.LogFrame(received);
+        if (!config.metricsAddress.empty()) {
+            app.RecordFrameMetrics(frame, frame.sampleTimeNs);
+        }
+        auto t3 = std::chrono::steady_clock::now();
+
+        uint64_t cpuAfter = ThreadCpuNs();
+        uint64_t allocationsAfter = g_allocationCount.load(std::memory_order_relaxed);
+
+        if (measure) {
+            sampleStep.Record(ElapsedNs(t0, t1));
+            ringHandoff.Record(ElapsedNs(t1, t2));
+            captureToDelivery.Record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t2.time_since_epoch()).count() - received.sampleTimeNs));
+            logStep.Record(ElapsedNs(t2, t3));
+            framePath.Record(ElapsedNs(t0, t3));
+            frameCpu.Record(cpuAfter - cpuBefore);
+            frameAllocations.Record(allocationsAfter - allocationsBefore);
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    double cpuSeconds = (ThreadCpuNs() - runCpuStart) / 1e9;
+    if (config.realtime.enabled) {
+        RestoreCurrentThreadScheduling(originalScheduling);
+    }
+
+    std::cout << std::endl;
+    std::cout << "=== BENCHMARK RESULTS ===" << std::endl;
+    std::cout << "Source: " << (options.openxr ? "OpenXR runtime" : (config.replayPath.empty() ? "synthetic" : "replay"))
+              << ", frames: " << options.frames << " (+" << options.warmupFrames << " warmup)"
+              << ", rate: ";
+    if (options.rateHz > 0.0) {
+        std::cout << options.rateHz << " Hz";
+    } else {
+        std::cout << "back-to-back";
+    }
+    std::cout << (config.realtime.enabled ? ", real-time" : "") << std::endl;
+    std::cout << "Wall " << std::fixed << std::setprecision(3) << wallSeconds << " s, thread CPU " << cpuSeconds
+              << " s, " << std::setprecision(0) << options.frames / wallSeconds << " frames/s"
+              << std::defaultfloat << std::endl;
+    std::cout << std::endl;
+
+    if (options.rateHz > 0.0) {
+        wakeLateness.Print(std::cout, "tick wake-up lateness");
+    }
+    locateCall.Print(std::cout, "xrLocateHandJointsEXT call");
+    sampleStep.Print(std::cout, "sample (both hands)");
+    ringHandoff.Print(std::cout, "ring push + pop");
+    captureToDelivery.Print(std::cout, "capture to delivery");
+    logStep.Print(std::cout, "log records");
+    framePath.Print(std::cout, "frame total");
+    frameCpu.Print(std::cout, "frame thread CPU");
+    frameAllocations.Print(std::cout, "heap allocations / frame", "allocs", 1.0);
+    std::cout << "=========================" << std::endl;
+
+    app.Shutdown();
+    return 0;
+}
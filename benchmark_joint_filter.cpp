@@ -0,0 +1,198 @@
+#include "joint_filter.h"
+#include "synthetic_hand_tracker.h"
+#include "latency_histogram.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+
+// ============================================================================
+// Joint filter benchmark
+// ============================================================================
+// Runs synthetic hands with position noise through each filter setting and
+// compares the output with the noise-free poses:
+//   - jitter: RMS second difference of joint positions, as on the status line
+//   - error: RMS distance from the true position at the same time
+//   - lag: the time shift of the true motion that best matches the output
+//     (positive = output is behind)
+//   - CPU time of JointFilter::Apply() per frame
+// ============================================================================
+
+struct FilterBenchmarkOptions {
+    double rateHz = 1000.0;
+    double seconds = 10.0;
+    float noiseMeters = 0.0005f;
+    double maxLagMs = 40.0;  // searched from -maxLagMs/2 to maxLagMs
+    JointFilterParams params[JOINT_GROUP_COUNT];
+};
+
+struct FilterSetting {
+    const char* name;
+    FilterMode mode;
+    float lagCompensation;
+};
+
+static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+static void FillFrame(SyntheticHandTracker& source, double t, HandFrame& frame) {
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        frame.hands[hand].result = XR_SUCCESS;
+        frame.hands[hand].isActive = XR_TRUE;
+        frame.hands[hand].jointCount = XR_HAND_JOINT_COUNT_EXT;
+        source.Generate(hand == 0 ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT, t, frame.hands[hand].joints);
+    }
+}
+
+// RMS joint position error of outputs against the true poses shiftS earlier
+static double RmsError(const std::vector<XrVector3f>& outputs, const FilterBenchmarkOptions& options, double shiftS) {
+    SyntheticHandTracker truth(0.0f);
+    HandFrame frame;
+    const size_t frames = outputs.size() / (HAND_COUNT * XR_HAND_JOINT_COUNT_EXT);
+    const size_t settle = static_cast<size_t>(options.rateHz);  // skip the first second
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = settle; i < frames; ++i) {
+        FillFrame(truth, i / options.rateHz - shiftS, frame);
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+                const XrVector3f& output = outputs[(i * HAND_COUNT + hand) * XR_HAND_JOINT_COUNT_EXT + j];
+                XrVector3f d = Sub(output, frame.hands[hand].joints[j].pose.position);
+                sum += Dot(d, d);
+                count++;
+            }
+        }
+    }
+    return count ? std::sqrt(sum / count) : 0.0;
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --rate <hz>         Sample rate (default 1000)" << std::endl;
+    std::cout << "  --seconds <s>       Length of the synthetic motion (default 10)" << std::endl;
+    std::cout << "  --noise <m>         Position noise in meters (default 0.0005)" << std::endl;
+    std::cout << "  --filter-param <group>.<name>=<value>  As for test_handtracking_only" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    FilterBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--rate" && hasValue) {
+            if (!ParseNumber(argv[++i], options.rateHz)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--seconds" && hasValue) {
+            if (!ParseNumber(argv[++i], options.seconds)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--noise" && hasValue) {
+            double noise = 0.0;
+            if (!ParseNumber(argv[++i], noise) || noise < 0.0) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+            options.noiseMeters = static_cast<float>(noise);
+        } else if (arg == "--filter-param" && hasValue) {
+            if (!ParseFilterParam(argv[++i], options.params)) {
+                std::cerr << "Invalid filter parameter: " << argv[i] << std::endl;
+                return -1;
+            }
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (options.rateHz <= 0.0 || options.seconds < 2.0) {
+        std::cerr << "--rate must be positive and --seconds at least 2" << std::endl;
+        return -1;
+    }
+
+    const FilterSetting settings[] = {
+        {"unfiltered", FilterMode::Off, 0.0f},
+        {"one-euro, no lag compensation", FilterMode::OneEuro, 0.0f},
+        {"one-euro", FilterMode::OneEuro, -1.0f},
+        {"kalman", FilterMode::Kalman, -1.0f},
+    };
+    const size_t frames = static_cast<size_t>(options.seconds * options.rateHz);
+
+    std::cout << std::endl;
+    std::cout << "=== JOINT FILTER RESULTS ===" << std::endl;
+    std::cout << frames << " frames at " << options.rateHz << " Hz, noise " << options.noiseMeters * 1000.0f << " mm" << std::endl;
+    for (const FilterSetting& setting : settings) {
+        JointFilterParams params[JOINT_GROUP_COUNT];
+        for (int g = 0; g < JOINT_GROUP_COUNT; ++g) {
+            params[g] = options.params[g];
+            if (setting.lagCompensation >= 0.0f) {
+                params[g].lagCompensation = setting.lagCompensation;
+            }
+        }
+        JointFilter filter;
+        filter.Configure(setting.mode, params);
+
+        SyntheticHandTracker source(options.noiseMeters);
+        HandFrame frame;
+        std::vector<XrVector3f> outputs(frames * HAND_COUNT * XR_HAND_JOINT_COUNT_EXT);
+        LatencyHistogram filterTime;
+        for (size_t i = 0; i < frames; ++i) {
+            double t = i / options.rateHz;
+            frame.frameIndex = i;
+            frame.sampleTimeNs = static_cast<int64_t>(t * 1e9);
+            FillFrame(source, t, frame);
+            auto t0 = std::chrono::steady_clock::now();
+            filter.Apply(frame);
+            auto t1 = std::chrono::steady_clock::now();
+            filterTime.Record(ElapsedNs(t0, t1));
+            for (int hand = 0; hand < HAND_COUNT; ++hand) {
+                for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+                    outputs[(i * HAND_COUNT + hand) * XR_HAND_JOINT_COUNT_EXT + j] = frame.hands[hand].joints[j].pose.position;
+                }
+            }
+            if (i == static_cast<size_t>(options.rateHz)) {
+                filter.TakeStats();  // jitter after the first second only
+            }
+        }
+        JointFilter::Stats stats = filter.TakeStats();
+
+        // Lag: coarse search in 1 ms steps, then refine to 0.1 ms
+        double bestShiftMs = 0.0;
+        double bestError = RmsError(outputs, options, 0.0);
+        const double zeroShiftError = bestError;
+        for (double step : {1.0, 0.1}) {
+            double center = bestShiftMs;
+            double low = step == 1.0 ? -options.maxLagMs / 2.0 : center - 1.0;
+            double high = step == 1.0 ? options.maxLagMs : center + 1.0;
+            for (double shiftMs = low; shiftMs <= high + 1e-9; shiftMs += step) {
+                double error = RmsError(outputs, options, shiftMs / 1000.0);
+                if (error < bestError) {
+                    bestError = error;
+                    bestShiftMs = shiftMs;
+                }
+            }
+        }
+
+        std::cout << std::endl << setting.name << ":" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        if (setting.mode == FilterMode::Off) {
+            std::cout << "  error vs truth " << zeroShiftError * 1000.0 << " mm RMS" << std::endl;
+        } else {
+            double rawJitter = stats.RawJitterM();
+            double filteredJitter = stats.FilteredJitterM();
+            std::cout << "  jitter " << rawJitter * 1000.0 << " -> " << filteredJitter * 1000.0 << " mm RMS ("
+                      << std::setprecision(1) << (filteredJitter > 0.0 ? rawJitter / filteredJitter : 0.0) << "x less)" << std::endl;
+            std::cout << std::setprecision(3) << "  error vs truth " << zeroShiftError * 1000.0 << " mm RMS, lag "
+                      << std::setprecision(1) << bestShiftMs << " ms" << std::endl;
+            filterTime.Print(std::cout, "  filter time", "us", 1000.0);
+        }
+        std::cout << std::defaultfloat;
+    }
+    std::cout << "============================" << std::endl;
+    return 0;
+}
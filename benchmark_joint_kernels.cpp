@@ -0,0 +1,229 @@
+#include "joint_kernels.h"
+#include "synthetic_hand_tracker.h"
+#include "latency_histogram.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+
+// ============================================================================
+// Joint kernel benchmark
+// ============================================================================
+// Computes the derived joint quantities (joint_kernels.h) for a set of
+// synthetic frames with a plain per-joint AoS implementation built on
+// pose_math.h, then with each kernel the CPU supports. Reports the time per
+// frame for each, and the largest difference of every kernel from the
+// per-joint reference.
+// ============================================================================
+
+struct KernelBenchmarkOptions {
+    uint32_t frames = 1024;      // distinct frames, cycled through
+    uint32_t iterations = 200;   // passes over all frames per kernel
+    uint32_t batch = 64;         // frames per timed batch
+    bool onlyOne = false;
+    JointKernelIsa isa = JointKernelIsa::Scalar;
+};
+
+static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// Joint-by-joint version of the kernels, as consumers wrote it before
+static void ComputeReference(const HandFrame& frame, const XrPosef& reference, HandFrameDerived& out) {
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const HandFrame::Hand& src = frame.hands[hand];
+        HandFrameDerived::Hand& dst = out.hands[hand];
+        const XrPosef wristInverse = PoseInverse(src.joints[XR_HAND_JOINT_WRIST_EXT].pose);
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const XrPosef& pose = src.joints[j].pose;
+            XrPosef local;
+            local.orientation = QuatMultiply(wristInverse.orientation, pose.orientation);
+            local.position = QuatRotate(wristInverse.orientation, Sub(pose.position, src.joints[XR_HAND_JOINT_WRIST_EXT].pose.position));
+            dst.localPx[j] = local.position.x;
+            dst.localPy[j] = local.position.y;
+            dst.localPz[j] = local.position.z;
+            dst.localQx[j] = local.orientation.x;
+            dst.localQy[j] = local.orientation.y;
+            dst.localQz[j] = local.orientation.z;
+            dst.localQw[j] = local.orientation.w;
+
+            XrPosef converted = PoseMultiply(reference, pose);
+            dst.refPx[j] = converted.position.x;
+            dst.refPy[j] = converted.position.y;
+            dst.refPz[j] = converted.position.z;
+            dst.refQx[j] = converted.orientation.x;
+            dst.refQy[j] = converted.orientation.y;
+            dst.refQz[j] = converted.orientation.z;
+            dst.refQw[j] = converted.orientation.w;
+
+            XrVector3f incoming = Sub(pose.position, src.joints[JOINT_PARENT[j]].pose.position);
+            XrVector3f outgoing = Sub(src.joints[JOINT_CHILD[j]].pose.position, pose.position);
+            dst.boneLength[j] = Length(incoming);
+            float lengths = Length(incoming) * Length(outgoing);
+            float cosine = lengths > 1e-6f ? Dot(incoming, outgoing) / lengths : 1.0f;
+            dst.bendAngle[j] = std::acos(std::max(-1.0f, std::min(1.0f, cosine)));
+        }
+        for (int finger = 0; finger < FINGER_COUNT; ++finger) {
+            float curl = 0.0f;
+            for (int j = FINGER_CURL_JOINTS[finger].first; j <= FINGER_CURL_JOINTS[finger].last; ++j) {
+                curl += dst.bendAngle[j];
+            }
+            dst.fingerCurl[finger] = curl;
+        }
+    }
+}
+
+struct KernelError {
+    float position = 0.0f;     // meters, over local/reference positions and bone lengths
+    float orientation = 0.0f;  // quaternion component difference
+    float angle = 0.0f;        // radians, over bend angles and curls
+};
+
+static void Accumulate(float& worst, float a, float b) {
+    worst = std::max(worst, std::fabs(a - b));
+}
+
+static void Compare(const HandFrameDerived& reference, const HandFrameDerived& result, KernelError& error) {
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const HandFrameDerived::Hand& a = reference.hands[hand];
+        const HandFrameDerived::Hand& b = result.hands[hand];
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            Accumulate(error.position, a.localPx[j], b.localPx[j]);
+            Accumulate(error.position, a.localPy[j], b.localPy[j]);
+            Accumulate(error.position, a.localPz[j], b.localPz[j]);
+            Accumulate(error.position, a.refPx[j], b.refPx[j]);
+            Accumulate(error.position, a.refPy[j], b.refPy[j]);
+            Accumulate(error.position, a.refPz[j], b.refPz[j]);
+            Accumulate(error.position, a.boneLength[j], b.boneLength[j]);
+            Accumulate(error.orientation, a.localQx[j], b.localQx[j]);
+            Accumulate(error.orientation, a.localQy[j], b.localQy[j]);
+            Accumulate(error.orientation, a.localQz[j], b.localQz[j]);
+            Accumulate(error.orientation, a.localQw[j], b.localQw[j]);
+            Accumulate(error.orientation, a.refQx[j], b.refQx[j]);
+            Accumulate(error.orientation, a.refQy[j], b.refQy[j]);
+            Accumulate(error.orientation, a.refQz[j], b.refQz[j]);
+            Accumulate(error.orientation, a.refQw[j], b.refQw[j]);
+            Accumulate(error.angle, a.bendAngle[j], b.bendAngle[j]);
+        }
+        for (int finger = 0; finger < FINGER_COUNT; ++finger) {
+            Accumulate(error.angle, a.fingerCurl[finger], b.fingerCurl[finger]);
+        }
+    }
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --frames <n>        Distinct synthetic frames (default 1024)" << std::endl;
+    std::cout << "  --iterations <n>    Passes over all frames per kernel (default 200)" << std::endl;
+    std::cout << "  --kernel <name>     Only run scalar, sse2 or avx2 (default: all supported)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    KernelBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--kernel" && hasValue) {
+            if (!ParseJointKernelIsa(argv[++i], options.isa)) {
+                std::cerr << "Unknown kernel: " << argv[i] << " (expected scalar, sse2 or avx2)" << std::endl;
+                return -1;
+            }
+            options.onlyOne = true;
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (options.frames == 0 || options.iterations == 0) {
+        std::cerr << "--frames and --iterations must be positive" << std::endl;
+        return -1;
+    }
+    options.batch = std::min(options.batch, options.frames);
+
+    // Synthetic frames at 1 kHz, and an arbitrary reference frame
+    SyntheticHandTracker source;
+    std::vector<HandFrame> frames(options.frames);
+    for (uint32_t i = 0; i < options.frames; ++i) {
+        double t = i / 1000.0;
+        frames[i].frameIndex = i;
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            frames[i].hands[hand].result = XR_SUCCESS;
+            frames[i].hands[hand].isActive = XR_TRUE;
+            frames[i].hands[hand].jointCount = XR_HAND_JOINT_COUNT_EXT;
+            source.Generate(hand == 0 ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT, t, frames[i].hands[hand].joints);
+        }
+    }
+    XrPosef reference;
+    reference.orientation = QuatFromAxisAngle({0.0f, 1.0f, 0.0f}, 0.7f);
+    reference.position = {0.5f, -1.2f, 2.0f};
+
+    std::cout << "Detected joint kernel: " << JointKernelIsaName(DetectJointKernelIsa()) << std::endl;
+
+    // Per-joint reference, timed the same way as the kernels
+    std::vector<HandFrameDerived> expected(options.frames);
+    LatencyHistogram referenceTime;
+    for (uint32_t iteration = 0; iteration < options.iterations; ++iteration) {
+        for (uint32_t start = 0; start + options.batch <= options.frames; start += options.batch) {
+            auto t0 = std::chrono::steady_clock::now();
+            for (uint32_t i = start; i < start + options.batch; ++i) {
+                ComputeReference(frames[i], reference, expected[i]);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            referenceTime.Record(ElapsedNs(t0, t1) / options.batch);
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << "=== JOINT KERNEL RESULTS ===" << std::endl;
+    std::cout << "Frames: " << options.frames << " x " << options.iterations << " iterations, "
+              << HAND_COUNT << " hands x " << XR_HAND_JOINT_COUNT_EXT << " joints" << std::endl;
+    std::cout << std::endl;
+    referenceTime.Print(std::cout, "per-joint AoS reference", "ns", 1.0);
+
+    HandFrameSoA soa;
+    HandFrameDerived derived;
+    for (JointKernelIsa isa : {JointKernelIsa::Scalar, JointKernelIsa::Sse2, JointKernelIsa::Avx2}) {
+        if ((options.onlyOne && isa != options.isa) || !IsJointKernelIsaSupported(isa)) {
+            continue;
+        }
+        JointKernels kernels(isa);
+        KernelError error;
+        for (uint32_t i = 0; i < options.frames; ++i) {
+            kernels.Compute(frames[i], reference, soa, derived);
+            Compare(expected[i], derived, error);
+        }
+
+        // Kernel alone (on an already transposed frame), then transpose + kernel
+        LatencyHistogram kernelTime;
+        LatencyHistogram totalTime;
+        for (uint32_t iteration = 0; iteration < options.iterations; ++iteration) {
+            for (uint32_t start = 0; start + options.batch <= options.frames; start += options.batch) {
+                ToSoA(frames[start], soa);
+                auto t0 = std::chrono::steady_clock::now();
+                for (uint32_t i = start; i < start + options.batch; ++i) {
+                    kernels.Compute(soa, reference, derived);
+                }
+                auto t1 = std::chrono::steady_clock::now();
+                for (uint32_t i = start; i < start + options.batch; ++i) {
+                    kernels.Compute(frames[i], reference, soa, derived);
+                }
+                auto t2 = std::chrono::steady_clock::now();
+                kernelTime.Record(ElapsedNs(t0, t1) / options.batch);
+                totalTime.Record(ElapsedNs(t1, t2) / options.batch);
+            }
+        }
+        std::string name = kernels.GetIsaName();
+        kernelTime.Print(std::cout, name + " kernel", "ns", 1.0);
+        totalTime.Print(std::cout, name + " transpose + kernel", "ns", 1.0);
+        std::cout << "  max error vs reference: position " << std::setprecision(3) << error.position * 1e6f << " um, quaternion "
+                  << error.orientation << ", angle " << error.angle * 57.29578f << " deg" << std::defaultfloat << std::endl;
+    }
+    std::cout << "============================" << std::endl;
+    return 0;
+}
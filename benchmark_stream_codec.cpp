@@ -0,0 +1,203 @@
+#include "udp_stream.h"
+#include "synthetic_hand_tracker.h"
+#include "latency_histogram.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+
+// ============================================================================
+// Stream codec loopback benchmark
+// ============================================================================
+// Encodes synthetic frames, sends them through a real UDP socket on
+// 127.0.0.1, receives and decodes them, and compares the result with the
+// original frame. Reports packet size (keyframes and delta frames
+// separately), encode and decode time, and reconstruction error for
+// positions and orientations. --loss drops every n-th packet before
+// sending to show how decoding recovers.
+// ============================================================================
+
+struct CodecBenchmarkOptions {
+    uint64_t frames = 20000;
+    double rateHz = 90.0;     // spacing of the synthetic sample times
+    uint32_t keyframeInterval = DEFAULT_STREAM_KEYFRAME_INTERVAL;
+    float noiseMeters = 0.0005f;
+    uint64_t dropEvery = 0;   // 0 = no loss
+    uint16_t port = 0;        // 0 = any free port
+};
+
+static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --frames <n>        Frames to encode (default 20000)" << std::endl;
+    std::cout << "  --rate <hz>         Sample rate the synthetic frames are generated at (default 90)" << std::endl;
+    std::cout << "  --keyframe <n>      Frames between keyframes (default " << DEFAULT_STREAM_KEYFRAME_INTERVAL << ")" << std::endl;
+    std::cout << "  --noise <m>         Synthetic position noise in meters (default 0.0005)" << std::endl;
+    std::cout << "  --loss <n>          Drop every n-th packet before sending (default 0 = none)" << std::endl;
+    std::cout << "  --port <n>          Loopback UDP port (default 0 = any free port)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    CodecBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            if (!ParseInteger(argv[++i], options.frames)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--rate" && hasValue) {
+            if (!ParseNumber(argv[++i], options.rateHz)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--keyframe" && hasValue) {
+            if (!ParseInteger(argv[++i], options.keyframeInterval)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--noise" && hasValue) {
+            double noise = 0.0;
+            if (!ParseNumber(argv[++i], noise) || noise < 0.0) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+            options.noiseMeters = static_cast<float>(noise);
+        } else if (arg == "--loss" && hasValue) {
+            if (!ParseInteger(argv[++i], options.dropEvery)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--port" && hasValue) {
+            if (!ParseInteger(argv[++i], options.port)) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (options.frames == 0 || options.rateHz <= 0.0 || options.keyframeInterval == 0) {
+        std::cerr << "--frames, --rate and --keyframe must be positive" << std::endl;
+        return -1;
+    }
+
+    // Loopback socket pair: bind the receiver, then look up the port it got
+    UdpStreamReceiver receiver;
+    if (!receiver.Open(options.port, "127.0.0.1")) {
+        return -1;
+    }
+    int sendSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in destination{};
+    socklen_t destinationLength = sizeof(destination);
+    if (sendSocket < 0 || getsockname(receiver.NativeHandle(), reinterpret_cast<sockaddr*>(&destination), &destinationLength) != 0) {
+        std::cerr << "Failed to set up loopback sockets: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    SyntheticHandTracker source(options.noiseMeters);
+    HandStreamEncoder encoder(options.keyframeInterval);
+    HandStreamDecoder decoder;
+    HandFrame frame;
+    HandFrame decoded;
+    uint8_t packet[STREAM_MAX_PACKET_SIZE];
+    uint8_t received[STREAM_MAX_PACKET_SIZE];
+
+    LatencyHistogram encodeTime;
+    LatencyHistogram decodeTime;
+    LatencyHistogram keyframeBytes;
+    LatencyHistogram deltaBytes;
+    LatencyHistogram allBytes;
+    LatencyHistogram positionError;     // micrometres
+    LatencyHistogram orientationError;  // millidegrees
+    uint64_t dropped = 0;
+    uint64_t undecodable = 0;
+    uint64_t jointsCompared = 0;
+
+    for (uint64_t i = 0; i < options.frames; ++i) {
+        double t = i / options.rateHz;
+        frame.frameIndex = i;
+        frame.sampleTimeNs = static_cast<int64_t>(t * 1e9);
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            frame.hands[hand].result = XR_SUCCESS;
+            frame.hands[hand].isActive = XR_TRUE;
+            frame.hands[hand].jointCount = XR_HAND_JOINT_COUNT_EXT;
+            source.Generate(hand == 0 ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT, t, frame.hands[hand].joints);
+        }
+
+        uint64_t keyframesBefore = encoder.GetKeyframeCount();
+        auto t0 = std::chrono::steady_clock::now();
+        size_t size = encoder.Encode(frame, packet, sizeof(packet));
+        auto t1 = std::chrono::steady_clock::now();
+        if (size == 0) {
+            std::cerr << "Packet did not fit in " << STREAM_MAX_PACKET_SIZE << " bytes" << std::endl;
+            return -1;
+        }
+        encodeTime.Record(ElapsedNs(t0, t1));
+        allBytes.Record(size);
+        (encoder.GetKeyframeCount() != keyframesBefore ? keyframeBytes : deltaBytes).Record(size);
+
+        if (options.dropEvery > 0 && (i + 1) % options.dropEvery == 0) {
+            dropped++;
+            continue;
+        }
+        if (sendto(sendSocket, packet, size, 0, reinterpret_cast<const sockaddr*>(&destination), destinationLength) < 0) {
+            std::cerr << "Send failed: " << std::strerror(errno) << std::endl;
+            return -1;
+        }
+        int length = receiver.Receive(received, sizeof(received), 1000);
+        if (length <= 0) {
+            std::cerr << "Loopback packet did not arrive" << std::endl;
+            return -1;
+        }
+
+        auto t2 = std::chrono::steady_clock::now();
+        StreamDecodeResult result = decoder.Decode(received, static_cast<size_t>(length), decoded);
+        auto t3 = std::chrono::steady_clock::now();
+        if (result != StreamDecodeResult::Ok) {
+            undecodable++;
+            continue;
+        }
+        decodeTime.Record(ElapsedNs(t2, t3));
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            for (uint32_t joint = 0; joint < XR_HAND_JOINT_COUNT_EXT; ++joint) {
+                const XrPosef& original = frame.hands[hand].joints[joint].pose;
+                const XrPosef& restored = decoded.hands[hand].joints[joint].pose;
+                positionError.Record(static_cast<uint64_t>(Distance(original.position, restored.position) * 1e6f + 0.5f));
+                orientationError.Record(static_cast<uint64_t>(QuatAngle(original.orientation, restored.orientation) * 57295.78f + 0.5f));
+                jointsCompared++;
+            }
+        }
+    }
+    ::close(sendSocket);
+
+    const size_t rawBytes = HAND_COUNT * XR_HAND_JOINT_COUNT_EXT * sizeof(XrHandJointLocationEXT);
+    std::cout << std::endl;
+    std::cout << "=== STREAM CODEC RESULTS ===" << std::endl;
+    std::cout << "Frames: " << options.frames << " at " << options.rateHz << " Hz, keyframe every "
+              << options.keyframeInterval << ", noise " << options.noiseMeters * 1000.0f << " mm" << std::endl;
+    std::cout << "Raw joint data: " << rawBytes << " bytes/frame; encoded mean " << std::fixed << std::setprecision(1)
+              << allBytes.Mean() << " bytes/frame (" << rawBytes / allBytes.Mean() << "x smaller), "
+              << allBytes.Mean() * options.rateHz * 8.0 / 1000.0 << " kbit/s" << std::defaultfloat << std::endl;
+    std::cout << "Packets dropped: " << dropped << ", undecodable (waiting for keyframe): " << undecodable
+              << ", joints compared: " << jointsCompared << std::endl;
+    std::cout << std::endl;
+
+    allBytes.Print(std::cout, "packet size (all)", "bytes", 1.0);
+    keyframeBytes.Print(std::cout, "packet size (keyframe)", "bytes", 1.0);
+    deltaBytes.Print(std::cout, "packet size (delta)", "bytes", 1.0);
+    encodeTime.Print(std::cout, "encode", "ns", 1.0);
+    decodeTime.Print(std::cout, "decode", "ns", 1.0);
+    positionError.Print(std::cout, "position error", "mm", 1000.0);
+    orientationError.Print(std::cout, "orientation error", "deg", 1000.0);
+    std::cout << "============================" << std::endl;
+    return 0;
+}
@@ -3,8 +3,17 @@
 echo "Building Manus Hand Tracking Test..."
 echo "===================================="
 
-# Build the handtracking test executable
-g++ -std=c++17 -o test_handtracking_only test_handtracking_only.cpp -L/usr/local/lib -lopenxr_loader -ldl
+# Build libhandtrack (all tracking code, behind the C API in
+# libhandtrack.h), the test executable and embedding example that link
+# against it (found next to them via $ORIGIN), the shared-memory reader
+# example, the UDP stream receiver and the recording analyzer (the last
+# three need the OpenXR headers but not the loader)
+g++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden -o libhandtrack.so libhandtrack.cpp -L/usr/local/lib -lopenxr_loader -ldl -pthread && \
+g++ -std=c++17 -O2 -o test_handtracking_only test_handtracking_only.cpp -L. -lhandtrack -Wl,-rpath,'$ORIGIN' && \
+g++ -std=c++17 -O2 -o libhandtrack_example libhandtrack_example.cpp -L. -lhandtrack -Wl,-rpath,'$ORIGIN' && \
+g++ -std=c++17 -o shm_reader_example shm_reader_example.cpp -pthread && \
+g++ -std=c++17 -O2 -o udp_receiver udp_receiver.cpp && \
+g++ -std=c++17 -O2 -o analyze_recordings analyze_recordings.cpp -pthread
 
 if [ $? -eq 0 ]; then
     echo "✅ Build successful!"
@@ -14,6 +23,21 @@ if [ $? -eq 0 ]; then
     echo ""
     echo "Or run directly:"
     echo "  ./test_handtracking_only"
+    echo ""
+    echo "To embed tracking in-process (see libhandtrack.h):"
+    echo "  ./libhandtrack_example --synthetic --verbosity 0"
+    echo ""
+    echo "To read frames from another process:"
+    echo "  ./test_handtracking_only --shm /handtracking"
+    echo "  ./shm_reader_example --shm /handtracking"
+    echo ""
+    echo "To stream frames to another machine:"
+    echo "  ./udp_receiver --port 9050                          (on the receiving machine)"
+    echo "  ./test_handtracking_only --stream <receiver-ip>:9050"
+    echo ""
+    echo "To triage recorded sessions:"
+    echo "  ./test_handtracking_only --rate 1000 --record session.htrec"
+    echo "  ./analyze_recordings *.htrec"
 else
     echo "❌ Build failed!"
     exit 1
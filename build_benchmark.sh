@@ -0,0 +1,35 @@
+#!/bin/bash
+
+echo "Building Manus Hand Tracking Benchmark..."
+echo "========================================="
+
+# Build the per-frame path benchmark (optimized, with symbols for profiling)
+g++ -std=c++17 -O2 -g -o benchmark_handtracking benchmark_handtracking.cpp -L/usr/local/lib -lopenxr_loader -ldl -pthread && \
+# Build the stream codec loopback benchmark (no OpenXR loader needed)
+g++ -std=c++17 -O2 -g -o benchmark_stream_codec benchmark_stream_codec.cpp -pthread && \
+# Build the joint kernel benchmark (no OpenXR loader needed)
+g++ -std=c++17 -O2 -g -o benchmark_joint_kernels benchmark_joint_kernels.cpp && \
+# Build the joint filter benchmark (no OpenXR loader needed)
+g++ -std=c++17 -O2 -g -o benchmark_joint_filter benchmark_joint_filter.cpp
+
+if [ $? -eq 0 ]; then
+    echo "✅ Build successful!"
+    echo ""
+    echo "To run against synthetic hand data (no gloves or SteamVR needed):"
+    echo "  ./benchmark_handtracking"
+    echo ""
+    echo "To run against the OpenXR runtime and Manus layer:"
+    echo "  ./benchmark_handtracking --openxr"
+    echo ""
+    echo "To measure the UDP stream codec over loopback:"
+    echo "  ./benchmark_stream_codec"
+    echo ""
+    echo "To compare the SIMD joint kernels with per-joint code:"
+    echo "  ./benchmark_joint_kernels"
+    echo ""
+    echo "To measure jitter, lag and CPU time of the joint filters:"
+    echo "  ./benchmark_joint_filter"
+else
+    echo "❌ Build failed!"
+    exit 1
+fi
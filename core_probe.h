@@ -0,0 +1,304 @@
+#pragma once
+
+#include "net_address.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+// ============================================================================
+// Manus Core probing
+// ============================================================================
+// xrConnectToRemoteMANUSCore blocks until the Core answers or the layer
+// gives up, so calling it for an address that is down stalls startup.
+// Before connecting, every candidate is probed at once with a
+// non-blocking TCP connect to its Core port. The first one that accepts
+// within the timeout is the one to connect to.
+//
+// The probe runs on its own thread so it overlaps instance and system
+// creation. Each target's name is resolved on a thread of its own, so a
+// slow DNS lookup only delays that target; a lookup still running at the
+// timeout is abandoned (its thread is joined when the prober goes away).
+// It only shows that something accepts connections on the port,
+// not that it is a healthy Core, but that is what separates a fast
+// startup from waiting out a dead address.
+// ============================================================================
+
+struct CoreProbeResult {
+    std::string target;      // as given: host, host:port or [host]:port
+    bool reachable = false;
+    double elapsedMs = 0.0;  // until the connect completed or failed
+    std::string error;       // why it is not reachable
+};
+
+// Splits a comma-separated list of host[:port] targets, skipping empty entries.
+// IPv6 literals with a port are written [host]:port.
+inline std::vector<std::string> ParseCoreTargets(const std::string& list) {
+    std::vector<std::string> targets;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == std::string::npos) {
+            comma = list.size();
+        }
+        if (comma > start) {
+            targets.push_back(list.substr(start, comma - start));
+        }
+        start = comma + 1;
+    }
+    return targets;
+}
+
+// The address part of a target, as passed to xrConnectToRemoteMANUSCore
+inline std::string CoreTargetHost(const std::string& target) {
+    std::string host;
+    std::string port = "0";
+    return SplitHostPort(target, host, port) ? host : target;
+}
+
+class CoreProber {
+public:
+    ~CoreProber() {
+        Wait();
+        JoinResolvers();
+    }
+
+    // Starts probing every target; defaultPort applies to targets without one
+    void Start(const std::vector<std::string>& targets, uint16_t defaultPort, std::chrono::milliseconds timeout) {
+        Wait();
+        JoinResolvers();
+        m_results.clear();
+        for (const std::string& target : targets) {
+            CoreProbeResult result;
+            result.target = target;
+            m_results.push_back(result);
+        }
+        m_selected = -1;
+        m_thread = std::thread(&CoreProber::Probe, this, defaultPort, timeout);
+    }
+
+    // Blocks until the probe is done. Returns the index of the first target
+    // that accepted a connection, or -1 if none did.
+    int Wait() {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        return m_selected;
+    }
+
+    // Valid after Wait()
+    const std::vector<CoreProbeResult>& GetResults() const { return m_results; }
+
+private:
+    // One name lookup, shared between its resolver thread and the probe.
+    // The probe gives up on it by setting abandoned; the resolver then
+    // frees the addresses itself.
+    struct Resolution {
+        std::string host;
+        std::string port;
+        std::mutex mutex;
+        bool done = false;
+        bool abandoned = false;
+        int error = 0;
+        addrinfo* addresses = nullptr;
+    };
+
+    std::vector<CoreProbeResult> m_results;
+    int m_selected = -1;
+    std::thread m_thread;
+    std::vector<std::unique_ptr<Resolution>> m_resolutions;
+    std::vector<std::thread> m_resolvers;
+    int m_wakePipe[2] = {-1, -1};  // resolvers write a byte when done
+
+    struct Attempt {
+        int socket = -1;
+        size_t result = 0;
+    };
+
+    void JoinResolvers() {
+        for (std::thread& resolver : m_resolvers) {
+            resolver.join();
+        }
+        m_resolvers.clear();
+        m_resolutions.clear();
+        for (int& fd : m_wakePipe) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    static void Resolve(Resolution* resolution, int wakeFd) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        int error = getaddrinfo(resolution->host.c_str(), resolution->port.c_str(), &hints, &addresses);
+        {
+            std::lock_guard<std::mutex> lock(resolution->mutex);
+            if (resolution->abandoned) {
+                if (error == 0) {
+                    freeaddrinfo(addresses);
+                }
+            } else {
+                resolution->done = true;
+                resolution->error = error;
+                resolution->addresses = error == 0 ? addresses : nullptr;
+            }
+        }
+        char byte = 0;
+        (void)!::write(wakeFd, &byte, 1);
+    }
+
+    // Starts a non-blocking connect to the first resolved address. Returns
+    // the socket, or -1 with result.error set.
+    static int StartConnect(CoreProbeResult& result, const addrinfo* addresses) {
+        int fd = socket(addresses->ai_family, addresses->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, addresses->ai_protocol);
+        if (fd >= 0 && connect(fd, addresses->ai_addr, addresses->ai_addrlen) != 0 && errno != EINPROGRESS) {
+            result.error = std::strerror(errno);
+            ::close(fd);
+            fd = -1;
+        } else if (fd < 0) {
+            result.error = std::strerror(errno);
+        }
+        return fd;
+    }
+
+    void Probe(uint16_t defaultPort, std::chrono::milliseconds timeout) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + timeout;
+        auto elapsedMs = [start]() {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        // Every lookup starts at once; a target whose address cannot be
+        // parsed fails right away. pending holds the indices of lookups
+        // whose connect has not started yet.
+        std::vector<size_t> pending;
+        bool canResolve = pipe2(m_wakePipe, O_CLOEXEC | O_NONBLOCK) == 0;
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            std::unique_ptr<Resolution> resolution(new Resolution);
+            resolution->port = std::to_string(defaultPort);
+            if (!SplitHostPort(m_results[i].target, resolution->host, resolution->port)) {
+                m_results[i].error = "invalid address (expected host, host:port or [host]:port)";
+            } else if (!canResolve) {
+                m_results[i].error = std::strerror(errno);
+            } else {
+                try {
+                    m_resolvers.emplace_back(&CoreProber::Resolve, resolution.get(), m_wakePipe[1]);
+                    pending.push_back(i);
+                } catch (const std::system_error& e) {
+                    m_results[i].error = e.what();
+                }
+            }
+            m_resolutions.push_back(std::move(resolution));
+        }
+
+        std::vector<Attempt> attempts;
+        std::vector<pollfd> descriptors;
+        while (m_selected < 0 && (!attempts.empty() || !pending.empty())) {
+            // Start connecting to every target resolved since the last round
+            for (size_t p = pending.size(); p-- > 0;) {
+                size_t i = pending[p];
+                Resolution& resolution = *m_resolutions[i];
+                std::lock_guard<std::mutex> lock(resolution.mutex);
+                if (!resolution.done) {
+                    continue;
+                }
+                pending.erase(pending.begin() + p);
+                int socket = -1;
+                if (resolution.error != 0) {
+                    m_results[i].error = gai_strerror(resolution.error);
+                } else {
+                    socket = StartConnect(m_results[i], resolution.addresses);
+                    freeaddrinfo(resolution.addresses);
+                    resolution.addresses = nullptr;
+                }
+                if (socket >= 0) {
+                    Attempt attempt;
+                    attempt.socket = socket;
+                    attempt.result = i;
+                    attempts.push_back(attempt);
+                } else {
+                    m_results[i].elapsedMs = elapsedMs();
+                }
+            }
+            if (attempts.empty() && pending.empty()) {
+                break;
+            }
+
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                break;
+            }
+            descriptors.clear();
+            for (const Attempt& attempt : attempts) {
+                descriptors.push_back({attempt.socket, POLLOUT, 0});
+            }
+            if (!pending.empty()) {
+                descriptors.push_back({m_wakePipe[0], POLLIN, 0});
+            }
+            int ready = poll(descriptors.data(), descriptors.size(), static_cast<int>(remaining.count()));
+            if (ready < 0 && errno != EINTR) {
+                break;
+            }
+            if (!pending.empty() && descriptors.back().revents != 0) {
+                char drain[64];
+                while (::read(m_wakePipe[0], drain, sizeof(drain)) > 0) {
+                }
+            }
+            for (size_t i = attempts.size(); i-- > 0;) {
+                if (descriptors[i].revents == 0) {
+                    continue;
+                }
+                CoreProbeResult& result = m_results[attempts[i].result];
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(attempts[i].socket, SOL_SOCKET, SO_ERROR, &error, &length);
+                result.elapsedMs = elapsedMs();
+                if (error == 0) {
+                    result.reachable = true;
+                    // Several may complete in the same poll; the earlier
+                    // entry in the list wins
+                    if (m_selected < 0 || attempts[i].result < static_cast<size_t>(m_selected)) {
+                        m_selected = static_cast<int>(attempts[i].result);
+                    }
+                } else {
+                    result.error = std::strerror(error);
+                }
+                ::close(attempts[i].socket);
+                attempts.erase(attempts.begin() + i);
+            }
+        }
+
+        const char* giveUp = m_selected >= 0 ? "abandoned, another target answered first" : "timed out";
+        for (const Attempt& attempt : attempts) {
+            CoreProbeResult& result = m_results[attempt.result];
+            result.elapsedMs = elapsedMs();
+            result.error = giveUp;
+            ::close(attempt.socket);
+        }
+        for (size_t i : pending) {
+            Resolution& resolution = *m_resolutions[i];
+            std::lock_guard<std::mutex> lock(resolution.mutex);
+            if (resolution.done && resolution.addresses != nullptr) {
+                freeaddrinfo(resolution.addresses);
+                resolution.addresses = nullptr;
+            }
+            resolution.abandoned = true;
+            m_results[i].elapsedMs = elapsedMs();
+            m_results[i].error = m_selected >= 0 ? giveUp : (resolution.done ? "timed out" : "timed out resolving the name");
+        }
+    }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "hand_frame.h"
+#include "spsc_ring.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
+
+// Drains one ring on its own thread and hands every item to a callback.
+// Used for consumers that may block (file, network) so that they can
+// never delay the sampler. Items are HandFrames or, for event
+// subscribers, GestureEvents; anything with a sampleTimeNs works.
+//
+// An idle consumer sleeps on a semaphore that Push() posts only when the
+// consumer is actually waiting, so frames are picked up immediately
+// instead of after the next poll, and the producer never blocks (sem_post
+// does not lock). The poll period remains as a backstop.
+//
+// Also measures capture-to-delivery latency: the time from an item's
+// sample time to the callback returning (frame written, sent, ...).
+template <typename T>
+class ConsumerThread {
+public:
+    using FrameHandler = std::function<void(const T&)>;
+    using IdleHandler = std::function<void()>;
+
+    ConsumerThread(size_t ringCapacity, OverflowPolicy policy)
+        : m_ring(ringCapacity, policy) {
+        sem_init(&m_wakeup, 0, 0);
+    }
+
+    ~ConsumerThread() {
+        Stop();
+        sem_destroy(&m_wakeup);
+    }
+
+    SpscRing<T>& Ring() { return m_ring; }
+
+    // Producer side: queue an item and wake the consumer if it is asleep
+    bool Push(const T& frame) {
+        bool pushed = m_ring.Push(frame);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_relaxed) && m_waiting.exchange(false)) {
+            sem_post(&m_wakeup);
+        }
+        return pushed;
+    }
+
+    // onIdle is called whenever the ring has been drained, and once more
+    // after the final drain on Stop()
+    void Start(FrameHandler onFrame, IdleHandler onIdle = nullptr,
+               std::chrono::microseconds pollPeriod = std::chrono::milliseconds(2)) {
+        m_onFrame = std::move(onFrame);
+        m_onIdle = std::move(onIdle);
+        m_pollPeriod = pollPeriod;
+        m_running.store(true);
+        m_thread = std::thread(&ConsumerThread::Loop, this);
+    }
+
+    void Stop() {
+        m_running.store(false);
+        sem_post(&m_wakeup);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    // Delivery latency since the last report, handed over every
+    // LATENCY_REPORT_PERIOD. Returns false if no new report is ready.
+    bool TakeDeliveryLatency(LatencyHistogram& out) {
+        if (!m_latencyReady.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = m_latencyReport;
+        m_latencyReady.store(false, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr std::chrono::seconds LATENCY_REPORT_PERIOD{5};
+    
+    SpscRing<T> m_ring;
+    FrameHandler m_onFrame;
+    IdleHandler m_onIdle;
+    std::chrono::microseconds m_pollPeriod{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+    sem_t m_wakeup;
+    std::atomic<bool> m_waiting{false};
+    
+    // Consumer thread only, except for the single-slot report hand-off
+    LatencyHistogram m_latency;
+    LatencyHistogram m_latencyReport;
+    std::atomic<bool> m_latencyReady{false};
+
+    void Loop() {
+        T frame;
+        auto lastReport = std::chrono::steady_clock::now();
+        while (true) {
+            bool running = m_running.load();
+            while (m_ring.Pop(frame)) {
+                m_onFrame(frame);
+                auto delivered = std::chrono::steady_clock::now();
+                int64_t deliveredNs = std::chrono::duration_cast<std::chrono::nanoseconds>(delivered.time_since_epoch()).count();
+                m_latency.Record(static_cast<uint64_t>(std::max<int64_t>(0, deliveredNs - frame.sampleTimeNs)));
+                if (delivered - lastReport >= LATENCY_REPORT_PERIOD) {
+                    PublishLatencyReport();
+                    lastReport = delivered;
+                }
+            }
+            if (m_onIdle) {
+                m_onIdle();
+            }
+            if (!running) {
+                break;
+            }
+            WaitForFrames();
+        }
+    }
+
+    // Hands the interval over unless the previous report is still unread,
+    // in which case the interval keeps growing until the next attempt
+    void PublishLatencyReport() {
+        if (m_latencyReady.load(std::memory_order_acquire)) {
+            return;
+        }
+        m_latencyReport = m_latency;
+        m_latency.Reset();
+        m_latencyReady.store(true, std::memory_order_release);
+    }
+
+    void WaitForFrames() {
+        // Announce the wait, then re-check so a push in between is not missed
+        m_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_ring.Size() == 0 && m_running.load()) {
+            timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            long nanoseconds = deadline.tv_nsec + static_cast<long>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(m_pollPeriod).count());
+            deadline.tv_sec += nanoseconds / 1000000000;
+            deadline.tv_nsec = nanoseconds % 1000000000;
+            while (sem_timedwait(&m_wakeup, &deadline) != 0 && errno == EINTR) {
+            }
+        }
+        m_waiting.store(false, std::memory_order_relaxed);
+    }
+};
+
+using FrameConsumerThread = ConsumerThread<HandFrame>;
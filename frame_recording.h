@@ -0,0 +1,522 @@
+#pragma once
+
+#include "hand_frame.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ============================================================================
+// Binary recording format (.htrec)
+// ============================================================================
+//
+//   [RecordingFileHeader]                          4096 bytes
+//   chunk 0: [RecordedFrame x chunkFrames][RecordingIndexBlock]
+//   chunk 1: [RecordedFrame x chunkFrames][RecordingIndexBlock]
+//   ...
+//   last chunk: [RecordedFrame x n]                (n < chunkFrames, no index block)
+//
+// Records have a fixed stride and every chunk has the same size, so frame N
+// lives at a computable offset and the file can be mmap()ed and indexed
+// directly. The chunk size is a multiple of the page size, keeping every
+// chunk page-aligned. The file is append-only: the frame count follows
+// from the file size, so a recording cut short by a crash is still readable
+// up to the last complete record.
+//
+// Each index block summarises the chunk in front of it (time range plus
+// every RECORDING_INDEX_STRIDE-th sample time) so a timestamp can be
+// located by estimating the chunk from the recording's time span and refining
+// within a few hundred bytes, without reading the records themselves.
+// ============================================================================
+
+constexpr char RECORDING_MAGIC[8] = {'H', 'T', 'R', 'E', 'C', '0', '1', '\0'};
+constexpr char RECORDING_INDEX_MAGIC[8] = {'H', 'T', 'I', 'D', 'X', '0', '1', '\0'};
+constexpr uint32_t RECORDING_VERSION = 1;
+constexpr uint32_t RECORDING_HEADER_SIZE = 4096;
+constexpr uint32_t RECORDING_CHUNK_FRAMES = 1024;
+constexpr uint32_t RECORDING_INDEX_STRIDE = 4;
+constexpr uint32_t RECORDING_INDEX_ENTRIES = RECORDING_CHUNK_FRAMES / RECORDING_INDEX_STRIDE;
+
+#pragma pack(push, 1)
+
+struct RecordedJoint {
+    float position[3];
+    float orientation[4];  // x, y, z, w
+    float radius;
+};
+
+struct RecordedHand {
+    int32_t result;          // XrResult of the locate call
+    uint32_t isActive;
+    uint32_t jointCount;
+    uint32_t reserved;
+    uint8_t locationFlags[XR_HAND_JOINT_COUNT_EXT];  // low byte of XrSpaceLocationFlags
+    uint8_t padding[6];
+    RecordedJoint joints[XR_HAND_JOINT_COUNT_EXT];
+};
+
+struct RecordedFrame {
+    uint64_t frameIndex;
+    int64_t sampleTimeNs;
+    RecordedHand hands[HAND_COUNT];
+};
+
+struct RecordingFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t chunkFrames;
+    uint32_t indexBlockSize;
+    uint32_t handCount;
+    uint32_t jointCount;
+    uint32_t jointSet;       // XrHandJointSetEXT
+    double sampleRateHz;     // target rate, 0 = free-running
+    int64_t startTimeNs;     // steady_clock time of the first record
+    int64_t startWallTimeNs; // system_clock time at start, for reference only
+    int64_t startLocateTime; // XrTime the first record was located for, 0 = unknown
+    uint8_t reserved[RECORDING_HEADER_SIZE - 72];
+};
+
+struct RecordingIndexBlock {
+    char magic[8];
+    uint64_t chunkNumber;
+    uint64_t firstFrameIndex;
+    int64_t firstSampleTimeNs;
+    int64_t lastSampleTimeNs;
+    uint32_t frameCount;
+    uint32_t indexStride;
+    int64_t sampleTimeNs[RECORDING_INDEX_ENTRIES];  // time of every indexStride-th record
+    uint8_t reserved[4096 - 48 - RECORDING_INDEX_ENTRIES * 8];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(RecordedHand) == 880, "RecordedHand layout changed");
+static_assert(sizeof(RecordedFrame) == 1776, "RecordedFrame layout changed");
+static_assert(sizeof(RecordingFileHeader) == RECORDING_HEADER_SIZE, "RecordingFileHeader must fill one page");
+static_assert(sizeof(RecordingIndexBlock) == 4096, "RecordingIndexBlock must fill one page");
+static_assert((sizeof(RecordedFrame) * RECORDING_CHUNK_FRAMES) % 4096 == 0, "Chunks must stay page-aligned");
+
+constexpr uint64_t RECORDING_CHUNK_SIZE =
+    uint64_t(sizeof(RecordedFrame)) * RECORDING_CHUNK_FRAMES + sizeof(RecordingIndexBlock);
+
+inline void ToRecordedFrame(const HandFrame& frame, RecordedFrame& record) {
+    record.frameIndex = frame.frameIndex;
+    record.sampleTimeNs = frame.sampleTimeNs;
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const HandFrame::Hand& src = frame.hands[hand];
+        RecordedHand& dst = record.hands[hand];
+        dst.result = static_cast<int32_t>(src.result);
+        dst.isActive = src.isActive;
+        dst.jointCount = src.jointCount;
+        dst.reserved = 0;
+        std::memset(dst.padding, 0, sizeof(dst.padding));
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const XrHandJointLocationEXT& joint = src.joints[j];
+            RecordedJoint& out = dst.joints[j];
+            dst.locationFlags[j] = static_cast<uint8_t>(joint.locationFlags & 0xFF);
+            out.position[0] = joint.pose.position.x;
+            out.position[1] = joint.pose.position.y;
+            out.position[2] = joint.pose.position.z;
+            out.orientation[0] = joint.pose.orientation.x;
+            out.orientation[1] = joint.pose.orientation.y;
+            out.orientation[2] = joint.pose.orientation.z;
+            out.orientation[3] = joint.pose.orientation.w;
+            out.radius = joint.radius;
+        }
+    }
+}
+
+inline void FromRecordedFrame(const RecordedFrame& record, HandFrame& frame) {
+    frame.frameIndex = record.frameIndex;
+    frame.sampleTimeNs = record.sampleTimeNs;
+    frame.locateTime = 0;  // not recorded per frame
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const RecordedHand& src = record.hands[hand];
+        HandFrame::Hand& dst = frame.hands[hand];
+        dst.result = static_cast<XrResult>(src.result);
+        dst.isActive = src.isActive;
+        dst.jointCount = std::min<uint32_t>(src.jointCount, XR_HAND_JOINT_COUNT_EXT);
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const RecordedJoint& in = src.joints[j];
+            XrHandJointLocationEXT& joint = dst.joints[j];
+            joint.locationFlags = src.locationFlags[j];
+            joint.pose.position = {in.position[0], in.position[1], in.position[2]};
+            joint.pose.orientation = {in.orientation[0], in.orientation[1], in.orientation[2], in.orientation[3]};
+            joint.radius = in.radius;
+        }
+    }
+}
+
+// File for the run-th recording made with one --record path: the path
+// itself for the first, then "-<run>" before the extension
+// (session.htrec, session-2.htrec, ...)
+inline std::string RecordingPathForRun(const std::string& path, uint32_t run) {
+    if (run <= 1) {
+        return path;
+    }
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash) || dot == slash + 1) {
+        dot = path.size();
+    }
+    return path.substr(0, dot) + "-" + std::to_string(run) + path.substr(dot);
+}
+
+// Append-only writer. Records are collected in a batch buffer and written
+// with one write() per batch, so the per-frame cost is a copy.
+class RecordingWriter {
+public:
+    static constexpr uint32_t BATCH_FRAMES = 64;
+
+    ~RecordingWriter() {
+        Close();
+    }
+
+    bool Open(const std::string& path, double sampleRateHz) {
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (m_fd < 0) {
+            std::cerr << "Failed to open recording file " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        m_path = path;
+        m_sampleRateHz = sampleRateHz;
+        m_batch.resize(BATCH_FRAMES);
+        m_batchCount = 0;
+        m_chunkFrameCount = 0;
+        m_chunkNumber = 0;
+        m_framesWritten = 0;
+        m_bytesWritten = 0;
+        m_headerWritten = false;
+        return true;
+    }
+
+    bool IsOpen() const { return m_fd >= 0; }
+    const std::string& GetPath() const { return m_path; }
+    uint64_t GetFramesWritten() const { return m_framesWritten.load(std::memory_order_relaxed); }
+    uint64_t GetBytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+
+    bool Append(const HandFrame& frame) {
+        if (m_fd < 0) {
+            return false;
+        }
+        if (!m_headerWritten && !WriteHeader(frame.sampleTimeNs, frame.locateTime)) {
+            return false;
+        }
+
+        RecordedFrame& record = m_batch[m_batchCount++];
+        ToRecordedFrame(frame, record);
+
+        // Keep the index for the current chunk up to date as we go
+        if (m_chunkFrameCount == 0) {
+            std::memset(&m_index, 0, sizeof(m_index));
+            std::memcpy(m_index.magic, RECORDING_INDEX_MAGIC, sizeof(m_index.magic));
+            m_index.chunkNumber = m_chunkNumber;
+            m_index.firstFrameIndex = frame.frameIndex;
+            m_index.firstSampleTimeNs = frame.sampleTimeNs;
+            m_index.indexStride = RECORDING_INDEX_STRIDE;
+        }
+        if (m_chunkFrameCount % RECORDING_INDEX_STRIDE == 0) {
+            m_index.sampleTimeNs[m_chunkFrameCount / RECORDING_INDEX_STRIDE] = frame.sampleTimeNs;
+        }
+        m_index.lastSampleTimeNs = frame.sampleTimeNs;
+        m_chunkFrameCount++;
+        m_framesWritten++;
+
+        // Chunks are a multiple of the batch size, so a full chunk always
+        // coincides with a full batch
+        if (m_batchCount == BATCH_FRAMES) {
+            if (!FlushBatch()) {
+                return false;
+            }
+            if (m_chunkFrameCount == RECORDING_CHUNK_FRAMES) {
+                m_index.frameCount = m_chunkFrameCount;
+                if (!WriteAll(&m_index, sizeof(m_index))) {
+                    return false;
+                }
+                m_chunkNumber++;
+                m_chunkFrameCount = 0;
+            }
+        }
+        return true;
+    }
+
+    // Writes out buffered records. The trailing partial chunk stays without
+    // an index block; readers treat it as a plain run of records.
+    bool Flush() {
+        return m_fd < 0 || FlushBatch();
+    }
+
+    void Close() {
+        if (m_fd < 0) {
+            return;
+        }
+        FlushBatch();
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+private:
+    static_assert(RECORDING_CHUNK_FRAMES % BATCH_FRAMES == 0, "Chunk must hold whole batches");
+
+    int m_fd = -1;
+    std::string m_path;
+    double m_sampleRateHz = 0.0;
+    bool m_headerWritten = false;
+
+    std::vector<RecordedFrame> m_batch;
+    uint32_t m_batchCount = 0;
+
+    RecordingIndexBlock m_index;
+    uint32_t m_chunkFrameCount = 0;
+    uint64_t m_chunkNumber = 0;
+
+    // Written by the recorder thread, read for the status line
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+
+    bool WriteHeader(int64_t startTimeNs, int64_t startLocateTime) {
+        RecordingFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+        header.version = RECORDING_VERSION;
+        header.headerSize = RECORDING_HEADER_SIZE;
+        header.recordSize = sizeof(RecordedFrame);
+        header.chunkFrames = RECORDING_CHUNK_FRAMES;
+        header.indexBlockSize = sizeof(RecordingIndexBlock);
+        header.handCount = HAND_COUNT;
+        header.jointCount = XR_HAND_JOINT_COUNT_EXT;
+        header.jointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+        header.sampleRateHz = m_sampleRateHz;
+        header.startTimeNs = startTimeNs;
+        header.startWallTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header.startLocateTime = startLocateTime;
+        m_headerWritten = WriteAll(&header, sizeof(header));
+        return m_headerWritten;
+    }
+
+    bool FlushBatch() {
+        if (m_batchCount == 0) {
+            return true;
+        }
+        bool ok = WriteAll(m_batch.data(), m_batchCount * sizeof(RecordedFrame));
+        m_batchCount = 0;
+        return ok;
+    }
+
+    bool WriteAll(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(m_fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Failed to write recording " << m_path << ": " << std::strerror(errno) << std::endl;
+                ::close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+            m_bytesWritten += static_cast<uint64_t>(written);
+        }
+        return true;
+    }
+};
+
+// Read-only view of a recording through mmap(). Frames are addressed by
+// their position in the file; nothing is parsed up front.
+class RecordingReader {
+public:
+    ~RecordingReader() {
+        Close();
+    }
+
+    bool Open(const std::string& path) {
+        Close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Failed to open recording " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < RECORDING_HEADER_SIZE) {
+            std::cerr << "Recording " << path << " is too short" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        m_size = static_cast<uint64_t>(st.st_size);
+        void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Failed to map recording " << path << ": " << std::strerror(errno) << std::endl;
+            m_size = 0;
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(mapping);
+
+        const RecordingFileHeader* header = Header();
+        if (std::memcmp(header->magic, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0 ||
+            header->version != RECORDING_VERSION ||
+            header->recordSize != sizeof(RecordedFrame) ||
+            header->chunkFrames != RECORDING_CHUNK_FRAMES ||
+            header->indexBlockSize != sizeof(RecordingIndexBlock)) {
+            std::cerr << "Recording " << path << " has an unsupported format" << std::endl;
+            Close();
+            return false;
+        }
+
+        uint64_t payload = m_size - RECORDING_HEADER_SIZE;
+        m_fullChunks = payload / RECORDING_CHUNK_SIZE;
+        uint64_t tailFrames = std::min<uint64_t>((payload % RECORDING_CHUNK_SIZE) / sizeof(RecordedFrame),
+                                                 RECORDING_CHUNK_FRAMES);
+        // A trailing chunk may hold all its records but no index block yet
+        m_chunkCount = m_fullChunks + (tailFrames > 0 ? 1 : 0);
+        m_frameCount = m_fullChunks * RECORDING_CHUNK_FRAMES + tailFrames;
+
+        madvise(const_cast<uint8_t*>(m_data), m_size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    void Close() {
+        if (m_data != nullptr) {
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+            m_data = nullptr;
+        }
+        m_size = 0;
+        m_frameCount = 0;
+        m_fullChunks = 0;
+        m_chunkCount = 0;
+    }
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const RecordingFileHeader* Header() const { return reinterpret_cast<const RecordingFileHeader*>(m_data); }
+    uint64_t FrameCount() const { return m_frameCount; }
+    uint64_t ChunkCount() const { return m_chunkCount; }
+
+    const RecordedFrame* Frame(uint64_t position) const {
+        uint64_t chunk = position / RECORDING_CHUNK_FRAMES;
+        uint64_t inChunk = position % RECORDING_CHUNK_FRAMES;
+        return reinterpret_cast<const RecordedFrame*>(
+            m_data + RECORDING_HEADER_SIZE + chunk * RECORDING_CHUNK_SIZE + inChunk * sizeof(RecordedFrame));
+    }
+
+    // Index block of a complete chunk, or nullptr for the trailing partial chunk
+    const RecordingIndexBlock* Index(uint64_t chunk) const {
+        if (chunk >= m_fullChunks) {
+            return nullptr;
+        }
+        const RecordingIndexBlock* index = reinterpret_cast<const RecordingIndexBlock*>(
+            m_data + RECORDING_HEADER_SIZE + chunk * RECORDING_CHUNK_SIZE +
+            uint64_t(RECORDING_CHUNK_FRAMES) * sizeof(RecordedFrame));
+        return std::memcmp(index->magic, RECORDING_INDEX_MAGIC, sizeof(RECORDING_INDEX_MAGIC)) == 0 ? index : nullptr;
+    }
+
+    // Position of the last frame sampled at or before timeNs (0 if timeNs
+    // precedes the recording). The chunk is estimated from the recording's
+    // time span and corrected using the index blocks: a steady recording
+    // needs a couple of lookups, and one with long pauses O(log chunks).
+    uint64_t FindFrameAtTime(int64_t timeNs) const {
+        if (m_frameCount == 0) {
+            return 0;
+        }
+        uint64_t chunk = FindChunkAtTime(timeNs, EstimateChunk(timeNs, ChunkCount()));
+
+        uint64_t first = chunk * RECORDING_CHUNK_FRAMES;
+        uint64_t count = std::min<uint64_t>(RECORDING_CHUNK_FRAMES, m_frameCount - first);
+        uint64_t low = 0;
+        uint64_t high = count;
+
+        // Narrow to one index stride using the index block when there is one
+        if (const RecordingIndexBlock* index = Index(chunk)) {
+            const int64_t* begin = index->sampleTimeNs;
+            const int64_t* end = begin + RECORDING_INDEX_ENTRIES;
+            uint64_t entry = static_cast<uint64_t>(std::upper_bound(begin, end, timeNs) - begin);
+            if (entry > 0) {
+                low = (entry - 1) * RECORDING_INDEX_STRIDE;
+            }
+            high = std::min<uint64_t>(count, entry * RECORDING_INDEX_STRIDE + 1);
+        }
+
+        // Binary search for the last record with sampleTimeNs <= timeNs
+        while (high - low > 1) {
+            uint64_t mid = low + (high - low) / 2;
+            if (Frame(first + mid)->sampleTimeNs <= timeNs) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return first + low;
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_frameCount = 0;
+    uint64_t m_fullChunks = 0;
+    uint64_t m_chunkCount = 0;
+
+    int64_t ChunkFirstTime(uint64_t chunk) const {
+        if (const RecordingIndexBlock* index = Index(chunk)) {
+            return index->firstSampleTimeNs;
+        }
+        return Frame(chunk * RECORDING_CHUNK_FRAMES)->sampleTimeNs;
+    }
+
+    // Last chunk starting at or before timeNs (0 if none does). Gallops
+    // outwards from the estimate until the chunk is bracketed, then bisects.
+    uint64_t FindChunkAtTime(int64_t timeNs, uint64_t estimate) const {
+        const uint64_t chunkCount = ChunkCount();
+        uint64_t low = 0;           // starts at or before timeNs, or is 0
+        uint64_t high = chunkCount; // starts after timeNs, or is past the end
+        uint64_t step = 1;
+        if (ChunkFirstTime(estimate) <= timeNs) {
+            low = estimate;
+            while (low + step < chunkCount && ChunkFirstTime(low + step) <= timeNs) {
+                low += step;
+                step *= 2;
+            }
+            high = std::min(chunkCount, low + step);
+        } else {
+            high = estimate;
+            while (high >= step && ChunkFirstTime(high - step) > timeNs) {
+                high -= step;
+                step *= 2;
+            }
+            low = high >= step ? high - step : 0;
+        }
+        while (high - low > 1) {
+            uint64_t mid = low + (high - low) / 2;
+            if (ChunkFirstTime(mid) <= timeNs) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    uint64_t EstimateChunk(int64_t timeNs, uint64_t chunkCount) const {
+        int64_t start = Frame(0)->sampleTimeNs;
+        int64_t end = Frame(m_frameCount - 1)->sampleTimeNs;
+        if (timeNs <= start || end <= start) {
+            return 0;
+        }
+        double fraction = static_cast<double>(timeNs - start) / static_cast<double>(end - start);
+        uint64_t position = static_cast<uint64_t>(fraction * static_cast<double>(m_frameCount - 1));
+        return std::min<uint64_t>(position / RECORDING_CHUNK_FRAMES, chunkCount - 1);
+    }
+};
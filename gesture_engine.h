@@ -0,0 +1,297 @@
+#pragma once
+
+#include "gesture_event.h"
+#include "joint_kernels.h"
+#include "pose_math.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+// ============================================================================
+// Incremental gesture detection
+// ============================================================================
+// Runs on the sampler thread after filtering and turns the frame stream
+// into a handful of events (gesture_event.h), so subscribers that only
+// care about hand state changes do not have to receive and evaluate every
+// frame.
+//
+// Each gesture is a per-frame condition with hysteresis (a stricter
+// threshold to start than to keep going) followed by debouncing (the new
+// state must hold for debounceMs before it is reported). A hand going
+// inactive ends its gestures first. While a gesture's joints are invalid
+// its state is held, not ended.
+//
+//   pinch  thumb tip to index tip distance
+//   grab   mean curl of index, middle, ring and little finger
+//   point  index extended while the other three fingers are curled
+//
+// Curl is the sum of the bend angles along a finger (joint_kernels.h):
+// 0 for a straight finger, about 4 rad for a closed fist.
+// ============================================================================
+
+struct GestureThresholds {
+    float pinchStartM = 0.020f;     // tips closer than this start a pinch...
+    float pinchEndM = 0.035f;       // ...and must separate past this to end it
+    float grabStartCurl = 2.8f;     // radians, mean over the four fingers
+    float grabEndCurl = 2.2f;
+    float pointExtendedCurl = 1.0f; // index curl below this starts a point...
+    float pointReleaseCurl = 1.4f;  // ...above this ends it
+    float pointFoldedCurl = 2.4f;   // other fingers' mean curl above this starts a point...
+    float pointUnfoldCurl = 2.0f;   // ...below this ends it
+    float debounceMs = 30.0f;
+};
+
+// Parses "<name>=<value>" (pinch-start, pinch-end, grab-start, grab-end,
+// point-extended, point-release, point-folded, point-unfold, debounce-ms)
+inline bool ParseGestureParam(const std::string& spec, GestureThresholds& thresholds) {
+    size_t equals = spec.find('=');
+    if (equals == std::string::npos) {
+        return false;
+    }
+    std::string name = spec.substr(0, equals);
+    std::string text = spec.substr(equals + 1);
+    char* end = nullptr;
+    float value = std::strtof(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(value) || value < 0.0f) {
+        return false;
+    }
+    float* field = name == "pinch-start" ? &thresholds.pinchStartM
+                 : name == "pinch-end" ? &thresholds.pinchEndM
+                 : name == "grab-start" ? &thresholds.grabStartCurl
+                 : name == "grab-end" ? &thresholds.grabEndCurl
+                 : name == "point-extended" ? &thresholds.pointExtendedCurl
+                 : name == "point-release" ? &thresholds.pointReleaseCurl
+                 : name == "point-folded" ? &thresholds.pointFoldedCurl
+                 : name == "point-unfold" ? &thresholds.pointUnfoldCurl
+                 : name == "debounce-ms" ? &thresholds.debounceMs
+                 : nullptr;
+    if (field == nullptr) {
+        return false;
+    }
+    *field = value;
+    return true;
+}
+
+// Hysteresis has to point the right way for every gesture
+inline bool ValidateGestureThresholds(const GestureThresholds& t) {
+    return t.pinchStartM <= t.pinchEndM && t.grabEndCurl <= t.grabStartCurl &&
+           t.pointExtendedCurl <= t.pointReleaseCurl && t.pointUnfoldCurl <= t.pointFoldedCurl;
+}
+
+class GestureEngine {
+public:
+    // Upper bound of Update()'s output: per hand, either the active state
+    // changes (with up to three gesture ends before it), or the gestures do
+    static constexpr int MAX_EVENTS_PER_FRAME = HAND_COUNT * 4;
+
+    void Configure(const GestureThresholds& thresholds) {
+        m_thresholds = thresholds;
+        m_debounceNs = static_cast<int64_t>(thresholds.debounceMs * 1e6);
+        Reset();
+    }
+
+    void Reset() {
+        for (HandState& state : m_hands) {
+            state = HandState{};
+        }
+    }
+
+    // Evaluates one frame and writes the state changes it confirms to
+    // events (room for MAX_EVENTS_PER_FRAME). Returns the event count.
+    // Allocation-free; the curl pass runs only while a hand is active.
+    int Update(const HandFrame& frame, GestureEvent* events) {
+        m_frame = &frame;
+        m_events = events;
+        m_count = 0;
+
+        bool anyActive = false;
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            anyActive = anyActive || IsTracked(frame.hands[hand]);
+        }
+        if (anyActive) {
+            m_kernels.Compute(frame, IDENTITY_POSE, m_soa, m_derived);
+        }
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            UpdateHand(hand);
+        }
+        return m_count;
+    }
+
+    uint64_t GetEventCount() const { return m_sequence.load(std::memory_order_relaxed); }
+    const GestureThresholds& GetThresholds() const { return m_thresholds; }
+
+private:
+    static constexpr XrPosef IDENTITY_POSE{{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+    static constexpr int GESTURE_COUNT = 3;
+    static constexpr GestureType START_EVENTS[GESTURE_COUNT] = {GestureType::PinchStart, GestureType::GrabStart, GestureType::PointStart};
+    static constexpr GestureType END_EVENTS[GESTURE_COUNT] = {GestureType::PinchEnd, GestureType::GrabEnd, GestureType::PointEnd};
+
+    // A boolean that only changes once the new value has held for the
+    // debounce time
+    struct Debounced {
+        bool on = false;
+        bool pending = false;
+        int64_t pendingSinceNs = 0;
+    };
+
+    struct HandState {
+        Debounced active;
+        Debounced gestures[GESTURE_COUNT];  // pinch, grab, point
+    };
+
+    // What one gesture measured this frame
+    struct Measurement {
+        bool valid = false;
+        bool condition = false;  // after hysteresis
+        float value = 0.0f;
+        XrVector3f position{0.0f, 0.0f, 0.0f};
+    };
+
+    GestureThresholds m_thresholds;
+    int64_t m_debounceNs = 30000000;
+    HandState m_hands[HAND_COUNT];
+    // Advanced on the sampler thread, read by Run() for the status line
+    std::atomic<uint32_t> m_sequence{0};
+
+    JointKernels m_kernels;
+    HandFrameSoA m_soa;
+    HandFrameDerived m_derived;
+
+    // Current Update() call
+    const HandFrame* m_frame = nullptr;
+    GestureEvent* m_events = nullptr;
+    int m_count = 0;
+
+    static bool IsTracked(const HandFrame::Hand& hand) {
+        return XR_SUCCEEDED(hand.result) && hand.isActive && hand.jointCount == XR_HAND_JOINT_COUNT_EXT;
+    }
+
+    static bool PositionValid(const HandFrame::Hand& hand, int joint) {
+        return (hand.joints[joint].locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) != 0;
+    }
+
+    // Returns true when the state flips; onsetNs is when the new value was
+    // first seen
+    bool Debounce(Debounced& state, bool value, int64_t& onsetNs) const {
+        if (value == state.on) {
+            state.pending = false;
+            return false;
+        }
+        const int64_t nowNs = m_frame->sampleTimeNs;
+        if (!state.pending) {
+            state.pending = true;
+            state.pendingSinceNs = nowNs;
+        }
+        if (nowNs - state.pendingSinceNs < m_debounceNs) {
+            return false;
+        }
+        state.on = value;
+        state.pending = false;
+        onsetNs = state.pendingSinceNs;
+        return true;
+    }
+
+    void Emit(int hand, GestureType type, int64_t onsetNs, float value, const XrVector3f& position) {
+        GestureEvent& event = m_events[m_count++];
+        event.frameIndex = m_frame->frameIndex;
+        event.sampleTimeNs = m_frame->sampleTimeNs;
+        event.onsetTimeNs = onsetNs;
+        event.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+        event.hand = static_cast<uint8_t>(hand);
+        event.type = type;
+        event.value = value;
+        event.position = position;
+    }
+
+    void UpdateHand(int hand) {
+        const HandFrame::Hand& data = m_frame->hands[hand];
+        HandState& state = m_hands[hand];
+        const bool tracked = IsTracked(data);
+        const XrVector3f palm = tracked ? data.joints[XR_HAND_JOINT_PALM_EXT].pose.position : XrVector3f{0.0f, 0.0f, 0.0f};
+
+        int64_t onsetNs = 0;
+        if (Debounce(state.active, tracked, onsetNs)) {
+            if (state.active.on) {
+                Emit(hand, GestureType::HandActive, onsetNs, 0.0f, palm);
+            } else {
+                // The hand is gone: close its gestures at the same onset
+                for (int g = 0; g < GESTURE_COUNT; ++g) {
+                    if (state.gestures[g].on) {
+                        Emit(hand, END_EVENTS[g], onsetNs, 0.0f, palm);
+                    }
+                    state.gestures[g] = Debounced{};
+                }
+                Emit(hand, GestureType::HandInactive, onsetNs, 0.0f, palm);
+            }
+        }
+        if (!state.active.on || !tracked) {
+            for (Debounced& gesture : state.gestures) {
+                gesture.pending = false;
+            }
+            return;
+        }
+
+        Measurement measurements[GESTURE_COUNT];
+        MeasurePinch(data, state.gestures[0].on, measurements[0]);
+        MeasureGrab(hand, state.gestures[1].on, palm, measurements[1]);
+        MeasurePoint(hand, data, state.gestures[2].on, measurements[2]);
+        for (int g = 0; g < GESTURE_COUNT; ++g) {
+            const Measurement& m = measurements[g];
+            if (!m.valid) {
+                state.gestures[g].pending = false;
+                continue;
+            }
+            if (Debounce(state.gestures[g], m.condition, onsetNs)) {
+                Emit(hand, state.gestures[g].on ? START_EVENTS[g] : END_EVENTS[g], onsetNs, m.value, m.position);
+            }
+        }
+    }
+
+    void MeasurePinch(const HandFrame::Hand& data, bool on, Measurement& m) const {
+        if (!PositionValid(data, XR_HAND_JOINT_THUMB_TIP_EXT) || !PositionValid(data, XR_HAND_JOINT_INDEX_TIP_EXT)) {
+            return;
+        }
+        const XrVector3f& thumb = data.joints[XR_HAND_JOINT_THUMB_TIP_EXT].pose.position;
+        const XrVector3f& index = data.joints[XR_HAND_JOINT_INDEX_TIP_EXT].pose.position;
+        m.valid = true;
+        m.value = Length(Sub(index, thumb));
+        m.condition = m.value < (on ? m_thresholds.pinchEndM : m_thresholds.pinchStartM);
+        m.position = Scale(Add(thumb, index), 0.5f);
+    }
+
+    void MeasureGrab(int hand, bool on, const XrVector3f& palm, Measurement& m) const {
+        const HandFrameDerived::Hand& derived = m_derived.hands[hand];
+        float sum = 0.0f;
+        for (int finger = 1; finger < FINGER_COUNT; ++finger) {
+            if (!derived.fingerCurlValid[finger]) {
+                return;
+            }
+            sum += derived.fingerCurl[finger];
+        }
+        m.valid = true;
+        m.value = sum / (FINGER_COUNT - 1);
+        m.condition = m.value > (on ? m_thresholds.grabEndCurl : m_thresholds.grabStartCurl);
+        m.position = palm;
+    }
+
+    void MeasurePoint(int hand, const HandFrame::Hand& data, bool on, Measurement& m) const {
+        const HandFrameDerived::Hand& derived = m_derived.hands[hand];
+        float others = 0.0f;
+        for (int finger = 1; finger < FINGER_COUNT; ++finger) {
+            if (!derived.fingerCurlValid[finger]) {
+                return;
+            }
+            if (finger > 1) {
+                others += derived.fingerCurl[finger];
+            }
+        }
+        others /= FINGER_COUNT - 2;
+        m.valid = true;
+        m.value = derived.fingerCurl[1];
+        m.condition = on ? (m.value < m_thresholds.pointReleaseCurl && others > m_thresholds.pointUnfoldCurl)
+                         : (m.value < m_thresholds.pointExtendedCurl && others > m_thresholds.pointFoldedCurl);
+        m.position = data.joints[XR_HAND_JOINT_INDEX_TIP_EXT].pose.position;
+    }
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "hand_frame.h"
+#include "hand_stream_codec.h"
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// Gesture events
+// ============================================================================
+// What the gesture engine (gesture_engine.h) emits instead of full frames:
+// a hand appearing or disappearing, and pinch / grab / point starting or
+// ending. Events are small and trivially copyable so they go through the
+// same preallocated rings as frames.
+//
+// Wire format, one UDP datagram per event, integers little-endian:
+//
+//   u16 magic, u8 version, u8 type, u8 hand, u32 sequence,
+//   u64 frame index, i64 sample time (ns), i64 onset time (ns),
+//   f32 value, f32 x, f32 y, f32 z
+// ============================================================================
+
+constexpr uint16_t GESTURE_EVENT_MAGIC = 0x4547;  // "GE"
+constexpr uint8_t GESTURE_EVENT_VERSION = 1;
+constexpr size_t GESTURE_EVENT_PACKET_SIZE = 49;
+
+enum class GestureType : uint8_t {
+    HandActive = 0,
+    HandInactive = 1,
+    PinchStart = 2,   // value = thumb-index tip distance (m), position = midpoint of the tips
+    PinchEnd = 3,
+    GrabStart = 4,    // value = mean curl of the four fingers (rad), position = palm
+    GrabEnd = 5,
+    PointStart = 6,   // value = index curl (rad), position = index tip
+    PointEnd = 7,
+};
+
+constexpr uint8_t GESTURE_TYPE_COUNT = 8;
+
+inline const char* GestureTypeName(GestureType type) {
+    switch (type) {
+        case GestureType::HandActive: return "hand active";
+        case GestureType::HandInactive: return "hand inactive";
+        case GestureType::PinchStart: return "pinch start";
+        case GestureType::PinchEnd: return "pinch end";
+        case GestureType::GrabStart: return "grab start";
+        case GestureType::GrabEnd: return "grab end";
+        case GestureType::PointStart: return "point start";
+        case GestureType::PointEnd: return "point end";
+    }
+    return "unknown";
+}
+
+struct GestureEvent {
+    uint64_t frameIndex = 0;    // frame in which the change was confirmed
+    int64_t sampleTimeNs = 0;   // sample time of that frame (steady_clock)
+    int64_t onsetTimeNs = 0;    // first sample that showed the new state, before debouncing
+    uint32_t sequence = 0;      // per-engine counter; gaps on a receiver are lost events
+    uint8_t hand = 0;
+    GestureType type = GestureType::HandActive;
+    float value = 0.0f;         // see GestureType
+    XrVector3f position{0.0f, 0.0f, 0.0f};
+};
+
+// ----------------------------------------------------------------------------
+// Encoding
+// ----------------------------------------------------------------------------
+
+inline uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float BitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Returns the packet size, or 0 if out is too small
+inline size_t EncodeGestureEvent(const GestureEvent& event, uint8_t* out, size_t capacity) {
+    StreamWriter writer(out, capacity);
+    writer.U16(GESTURE_EVENT_MAGIC);
+    writer.U8(GESTURE_EVENT_VERSION);
+    writer.U8(static_cast<uint8_t>(event.type));
+    writer.U8(event.hand);
+    writer.U32(event.sequence);
+    writer.U64(event.frameIndex);
+    writer.U64(static_cast<uint64_t>(event.sampleTimeNs));
+    writer.U64(static_cast<uint64_t>(event.onsetTimeNs));
+    writer.U32(FloatBits(event.value));
+    writer.U32(FloatBits(event.position.x));
+    writer.U32(FloatBits(event.position.y));
+    writer.U32(FloatBits(event.position.z));
+    return writer.Overflow() ? 0 : writer.Size();
+}
+
+// Cheap check for telling event packets from frame packets on one port
+inline bool IsGestureEventPacket(const uint8_t* data, size_t size) {
+    return size >= 2 && (data[0] | (data[1] << 8)) == GESTURE_EVENT_MAGIC;
+}
+
+inline bool DecodeGestureEvent(const uint8_t* data, size_t size, GestureEvent& event) {
+    StreamReader reader(data, size);
+    if (size != GESTURE_EVENT_PACKET_SIZE || reader.U16() != GESTURE_EVENT_MAGIC || reader.U8() != GESTURE_EVENT_VERSION) {
+        return false;
+    }
+    uint8_t type = reader.U8();
+    event.hand = reader.U8();
+    event.sequence = reader.U32();
+    event.frameIndex = reader.U64();
+    event.sampleTimeNs = static_cast<int64_t>(reader.U64());
+    event.onsetTimeNs = static_cast<int64_t>(reader.U64());
+    event.value = BitsFloat(reader.U32());
+    event.position.x = BitsFloat(reader.U32());
+    event.position.y = BitsFloat(reader.U32());
+    event.position.z = BitsFloat(reader.U32());
+    if (reader.Error() || type >= GESTURE_TYPE_COUNT || event.hand >= HAND_COUNT) {
+        return false;
+    }
+    event.type = static_cast<GestureType>(type);
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "openxr_minimal.h"
+#include <cstdint>
+
+// Number of hands sampled per frame (index 0 = left, 1 = right)
+constexpr int HAND_COUNT = 2;
+
+// Where a hand's joint velocities came from
+enum class VelocitySource : uint32_t {
+    None = 0,       // no velocities (hand not located, or no previous sample yet)
+    Runtime = 1,    // XrHandJointVelocitiesEXT filled in by the runtime / API layer
+    Estimated = 2   // finite differences against the previous sample
+};
+
+// One sample of both hands as returned by xrLocateHandJointsEXT.
+//
+// Fixed-size and trivially copyable so it can be passed through the
+// preallocated frame rings without allocation.
+struct HandFrame {
+    uint64_t frameIndex = 0;
+    int64_t sampleTimeNs = 0;  // steady_clock (CLOCK_MONOTONIC) time at which the sample was taken
+    XrTime locateTime = 0;     // XrTime the joints were located for: sample time + prediction offset
+
+    struct Hand {
+        XrResult result = XR_ERROR_HANDLE_INVALID;  // result of the locate call
+        XrBool32 isActive = XR_FALSE;
+        uint32_t jointCount = 0;
+        XrHandJointLocationEXT joints[XR_HAND_JOINT_COUNT_EXT];
+        VelocitySource velocitySource = VelocitySource::None;
+        XrHandJointVelocityEXT velocities[XR_HAND_JOINT_COUNT_EXT];  // valid per velocityFlags
+    } hands[HAND_COUNT];
+};
+
+inline const char* HandName(int hand) {
+    return (hand == 0) ? "LEFT" : "RIGHT";
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "hand_frame.h"
+#include <cstring>
+
+// ============================================================================
+// Structure-of-arrays view of a HandFrame
+// ============================================================================
+// HandFrame stores each joint as an XrHandJointLocationEXT (array of
+// structures). For math over a whole hand it is much cheaper to keep one
+// array per component, so a SIMD register holds the same component of 4
+// or 8 joints. Each hand is padded from 26 to SOA_LANES joints (padding
+// lanes are zero and invalid) so kernels never need a scalar tail.
+//
+// Besides the joints themselves, the parent and child joint positions are
+// gathered during the transpose, so bone and bend-angle kernels need no
+// gathers of their own.
+// ============================================================================
+
+constexpr int SOA_LANES = 32;
+
+// Joint the bone into each joint starts at (wrist is its own parent)
+constexpr int JOINT_PARENT[XR_HAND_JOINT_COUNT_EXT] = {
+    1, 1,               // palm, wrist
+    1, 2, 3, 4,         // thumb
+    1, 6, 7, 8, 9,      // index
+    1, 11, 12, 13, 14,  // middle
+    1, 16, 17, 18, 19,  // ring
+    1, 21, 22, 23, 24}; // little
+
+// Next joint along the finger (palm, wrist and tips are their own child)
+constexpr int JOINT_CHILD[XR_HAND_JOINT_COUNT_EXT] = {
+    0, 1,
+    3, 4, 5, 5,
+    7, 8, 9, 10, 10,
+    12, 13, 14, 15, 15,
+    17, 18, 19, 20, 20,
+    22, 23, 24, 25, 25};
+
+constexpr int FINGER_COUNT = 5;
+
+// Joints whose bend angles add up to a finger's curl (MCP, PIP, DIP; MCP
+// and IP for the thumb)
+struct FingerCurlJoints {
+    int first;
+    int last;
+};
+constexpr FingerCurlJoints FINGER_CURL_JOINTS[FINGER_COUNT] = {
+    {XR_HAND_JOINT_THUMB_PROXIMAL_EXT, XR_HAND_JOINT_THUMB_DISTAL_EXT},
+    {XR_HAND_JOINT_INDEX_PROXIMAL_EXT, XR_HAND_JOINT_INDEX_DISTAL_EXT},
+    {XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT, XR_HAND_JOINT_MIDDLE_DISTAL_EXT},
+    {XR_HAND_JOINT_RING_PROXIMAL_EXT, XR_HAND_JOINT_RING_DISTAL_EXT},
+    {XR_HAND_JOINT_LITTLE_PROXIMAL_EXT, XR_HAND_JOINT_LITTLE_DISTAL_EXT}};
+
+inline const char* FingerName(int finger) {
+    static const char* const names[FINGER_COUNT] = {"Thumb", "Index", "Middle", "Ring", "Little"};
+    return finger >= 0 && finger < FINGER_COUNT ? names[finger] : "Unknown";
+}
+
+struct alignas(32) HandFrameSoA {
+    struct alignas(32) Hand {
+        // Joint poses; valid arrays are 1.0f or 0.0f
+        float px[SOA_LANES], py[SOA_LANES], pz[SOA_LANES];
+        float qx[SOA_LANES], qy[SOA_LANES], qz[SOA_LANES], qw[SOA_LANES];
+        float positionValid[SOA_LANES];
+        float orientationValid[SOA_LANES];
+
+        // Positions of each joint's parent and child (see JOINT_PARENT/CHILD)
+        float parentPx[SOA_LANES], parentPy[SOA_LANES], parentPz[SOA_LANES], parentValid[SOA_LANES];
+        float childPx[SOA_LANES], childPy[SOA_LANES], childPz[SOA_LANES], childValid[SOA_LANES];
+
+        XrPosef wrist;
+        bool wristValid;  // wrist position and orientation both valid
+    } hands[HAND_COUNT];
+};
+
+// Transposes a frame into SoA form. Hands whose locate call failed or that
+// are inactive come out with every joint invalid.
+inline void ToSoA(const HandFrame& frame, HandFrameSoA& soa) {
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        const HandFrame::Hand& src = frame.hands[hand];
+        HandFrameSoA::Hand& dst = soa.hands[hand];
+        std::memset(&dst, 0, sizeof(dst));
+        dst.wrist.orientation.w = 1.0f;
+        if (XR_FAILED(src.result) || !src.isActive) {
+            continue;
+        }
+
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const XrHandJointLocationEXT& joint = src.joints[j];
+            dst.px[j] = joint.pose.position.x;
+            dst.py[j] = joint.pose.position.y;
+            dst.pz[j] = joint.pose.position.z;
+            dst.qx[j] = joint.pose.orientation.x;
+            dst.qy[j] = joint.pose.orientation.y;
+            dst.qz[j] = joint.pose.orientation.z;
+            dst.qw[j] = joint.pose.orientation.w;
+            dst.positionValid[j] = (joint.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) ? 1.0f : 0.0f;
+            dst.orientationValid[j] = (joint.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) ? 1.0f : 0.0f;
+        }
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const int parent = JOINT_PARENT[j];
+            const int child = JOINT_CHILD[j];
+            dst.parentPx[j] = dst.px[parent];
+            dst.parentPy[j] = dst.py[parent];
+            dst.parentPz[j] = dst.pz[parent];
+            dst.parentValid[j] = dst.positionValid[parent];
+            dst.childPx[j] = dst.px[child];
+            dst.childPy[j] = dst.py[child];
+            dst.childPz[j] = dst.pz[child];
+            dst.childValid[j] = dst.positionValid[child];
+        }
+
+        const XrHandJointLocationEXT& wrist = src.joints[XR_HAND_JOINT_WRIST_EXT];
+        dst.wristValid = (wrist.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) &&
+                         (wrist.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT);
+        if (dst.wristValid) {
+            dst.wrist = wrist.pose;
+        }
+    }
+}
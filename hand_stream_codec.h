@@ -0,0 +1,543 @@
+#pragma once
+
+#include "hand_frame.h"
+#include "pose_math.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// Compact wire format for streaming hand frames
+// ============================================================================
+// One packet per frame, all integers little-endian:
+//
+//   header   u16 magic, u8 version, u8 packet flags (KEYFRAME),
+//            u32 frame index (low 32 bits), u32 keyframe index the deltas
+//            refer to, i64 sample time (ns)
+//   hand x2  u8 hand flags; if the locate call failed: i32 XrResult,
+//            otherwise u32 joint mask followed by one entry per set bit
+//   joint    u8 joint flags: XrSpaceLocationFlags in the low nibble plus
+//            ABSOLUTE / SAME_POSITION / SAME_ORIENTATION, then
+//            position     3 zigzag varints (quarter millimetres)
+//            orientation  u32 smallest-three quaternion
+//            radius       u16 quarter millimetres (absolute joints only)
+//
+// Positions are fixed-point. When the wrist is valid, every other joint is
+// expressed in the wrist's frame, so a hand that moves rigidly leaves the
+// finger values unchanged. The wrist frame is rebuilt from the quantized
+// wrist pose on both sides, so this adds no error.
+//
+// Keyframes carry every valid joint. Delta frames refer to the last
+// keyframe (not the previous packet), so a lost delta packet costs one
+// frame and never corrupts later ones. In a delta frame, a joint is left
+// out entirely if its quantized value and flags match the keyframe.
+// Positions are sent as varint differences. An orientation that matches
+// the keyframe is flagged instead of sent. Joints that have no valid
+// position or orientation are never sent.
+// ============================================================================
+
+constexpr uint16_t STREAM_MAGIC = 0x5348;  // "HS"
+constexpr uint8_t STREAM_VERSION = 1;
+constexpr float STREAM_POSITION_UNITS_PER_METER = 4000.0f;  // quarter millimetres
+constexpr size_t STREAM_HEADER_SIZE = 20;
+constexpr size_t STREAM_MAX_PACKET_SIZE = 1400;  // worst case is ~1.2 KB, below a typical MTU
+constexpr uint32_t DEFAULT_STREAM_KEYFRAME_INTERVAL = 30;
+constexpr uint16_t DEFAULT_STREAM_PORT = 9050;
+
+constexpr uint8_t STREAM_PACKET_KEYFRAME = 0x01;
+
+constexpr uint8_t STREAM_HAND_LOCATED = 0x01;         // locate call succeeded
+constexpr uint8_t STREAM_HAND_ACTIVE = 0x02;
+constexpr uint8_t STREAM_HAND_WRIST_RELATIVE = 0x04;  // joints are in the wrist frame
+constexpr uint8_t STREAM_HAND_FULL = 0x08;            // no reference: absent joints are invalid
+
+constexpr uint8_t STREAM_JOINT_LOCATION_MASK = 0x0F;  // XR_SPACE_LOCATION_*_BIT
+constexpr uint8_t STREAM_JOINT_SAME_ORIENTATION = 0x20;
+constexpr uint8_t STREAM_JOINT_SAME_POSITION = 0x40;
+constexpr uint8_t STREAM_JOINT_ABSOLUTE = 0x80;       // values are not deltas, radius included
+
+constexpr uint8_t STREAM_JOINT_VALID_BITS = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+
+// ----------------------------------------------------------------------------
+// Quantization
+// ----------------------------------------------------------------------------
+
+inline int32_t QuantizePosition(float meters) {
+    return static_cast<int32_t>(std::lrint(meters * STREAM_POSITION_UNITS_PER_METER));
+}
+
+inline float DequantizePosition(int32_t units) {
+    return static_cast<float>(units) / STREAM_POSITION_UNITS_PER_METER;
+}
+
+// Smallest-three: drop the largest component (recomputed from the unit
+// norm), store its index in 2 bits and the other three in 10 bits each.
+// Worst-case angular error is about 0.1 degrees.
+inline uint32_t PackQuaternion(const XrQuaternionf& orientation) {
+    XrQuaternionf q = QuatNormalize(orientation);
+    const float c[4] = {q.x, q.y, q.z, q.w};
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) {
+            largest = i;
+        }
+    }
+    const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+    const float scale = 0.70710678f;  // the other components lie in [-1/sqrt(2), 1/sqrt(2)]
+
+    uint32_t packed = static_cast<uint32_t>(largest) << 30;
+    int shift = 20;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        float normalized = (c[i] * sign / scale) * 0.5f + 0.5f;
+        long value = std::lrint(normalized * 1023.0f);
+        value = value < 0 ? 0 : (value > 1023 ? 1023 : value);
+        packed |= static_cast<uint32_t>(value) << shift;
+        shift -= 10;
+    }
+    return packed;
+}
+
+inline XrQuaternionf UnpackQuaternion(uint32_t packed) {
+    const float scale = 0.70710678f;
+    const int largest = static_cast<int>(packed >> 30);
+    float c[4];
+    float sumSquares = 0.0f;
+    int shift = 20;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        float normalized = static_cast<float>((packed >> shift) & 0x3FF) / 1023.0f;
+        c[i] = (normalized - 0.5f) * 2.0f * scale;
+        sumSquares += c[i] * c[i];
+        shift -= 10;
+    }
+    c[largest] = std::sqrt(sumSquares < 1.0f ? 1.0f - sumSquares : 0.0f);
+    return QuatNormalize({c[0], c[1], c[2], c[3]});
+}
+
+// One hand in wire units. Encoder and decoder both keep the last keyframe
+// in this form, so deltas are computed on identical integers.
+struct QuantizedHand {
+    bool located = false;
+    bool active = false;
+    bool wristRelative = false;
+    int32_t result = XR_ERROR_HANDLE_INVALID;
+    uint8_t flags[XR_HAND_JOINT_COUNT_EXT];
+    int32_t position[XR_HAND_JOINT_COUNT_EXT][3];  // wrist: world; others: wrist frame if wristRelative
+    uint32_t orientation[XR_HAND_JOINT_COUNT_EXT];
+    uint16_t radius[XR_HAND_JOINT_COUNT_EXT];
+};
+
+// Wrist pose as the decoder will see it
+inline XrPosef QuantizedWristPose(const QuantizedHand& q) {
+    XrPosef wrist;
+    wrist.position = {DequantizePosition(q.position[XR_HAND_JOINT_WRIST_EXT][0]),
+                      DequantizePosition(q.position[XR_HAND_JOINT_WRIST_EXT][1]),
+                      DequantizePosition(q.position[XR_HAND_JOINT_WRIST_EXT][2])};
+    wrist.orientation = UnpackQuaternion(q.orientation[XR_HAND_JOINT_WRIST_EXT]);
+    return wrist;
+}
+
+inline void QuantizeHand(const HandFrame::Hand& hand, QuantizedHand& q) {
+    q.located = XR_SUCCEEDED(hand.result);
+    q.active = q.located && hand.isActive;
+    q.result = hand.result;
+    std::memset(q.flags, 0, sizeof(q.flags));
+    std::memset(q.position, 0, sizeof(q.position));
+    std::memset(q.orientation, 0, sizeof(q.orientation));
+    std::memset(q.radius, 0, sizeof(q.radius));
+    if (!q.located) {
+        q.wristRelative = false;
+        return;
+    }
+
+    const XrHandJointLocationEXT& wrist = hand.joints[XR_HAND_JOINT_WRIST_EXT];
+    q.wristRelative = (wrist.locationFlags & STREAM_JOINT_VALID_BITS) == STREAM_JOINT_VALID_BITS;
+    XrPosef wristInverse{};
+    if (q.wristRelative) {
+        q.position[XR_HAND_JOINT_WRIST_EXT][0] = QuantizePosition(wrist.pose.position.x);
+        q.position[XR_HAND_JOINT_WRIST_EXT][1] = QuantizePosition(wrist.pose.position.y);
+        q.position[XR_HAND_JOINT_WRIST_EXT][2] = QuantizePosition(wrist.pose.position.z);
+        q.orientation[XR_HAND_JOINT_WRIST_EXT] = PackQuaternion(wrist.pose.orientation);
+        wristInverse = PoseInverse(QuantizedWristPose(q));
+    }
+
+    for (uint32_t joint = 0; joint < XR_HAND_JOINT_COUNT_EXT; ++joint) {
+        const XrHandJointLocationEXT& location = hand.joints[joint];
+        q.flags[joint] = static_cast<uint8_t>(location.locationFlags & STREAM_JOINT_LOCATION_MASK);
+        if ((q.flags[joint] & STREAM_JOINT_VALID_BITS) == 0) {
+            continue;
+        }
+        float radius = location.radius * STREAM_POSITION_UNITS_PER_METER;
+        q.radius[joint] = static_cast<uint16_t>(radius <= 0.0f ? 0 : (radius >= 65535.0f ? 65535 : std::lrint(radius)));
+        if (q.wristRelative && joint == XR_HAND_JOINT_WRIST_EXT) {
+            continue;
+        }
+        if (q.flags[joint] & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
+            XrVector3f position = q.wristRelative ? Add(wristInverse.position, QuatRotate(wristInverse.orientation, location.pose.position))
+                                                  : location.pose.position;
+            q.position[joint][0] = QuantizePosition(position.x);
+            q.position[joint][1] = QuantizePosition(position.y);
+            q.position[joint][2] = QuantizePosition(position.z);
+        }
+        if (q.flags[joint] & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) {
+            q.orientation[joint] = PackQuaternion(location.pose.orientation);
+        }
+    }
+}
+
+inline void DequantizeHand(const QuantizedHand& q, HandFrame::Hand& hand) {
+    hand.result = q.located ? XR_SUCCESS : static_cast<XrResult>(q.result);
+    hand.isActive = q.active ? XR_TRUE : XR_FALSE;
+    hand.jointCount = q.located ? XR_HAND_JOINT_COUNT_EXT : 0;
+    if (!q.located) {
+        return;
+    }
+
+    const XrPosef wrist = q.wristRelative ? QuantizedWristPose(q) : XrPosef{};
+    for (uint32_t joint = 0; joint < XR_HAND_JOINT_COUNT_EXT; ++joint) {
+        XrHandJointLocationEXT& location = hand.joints[joint];
+        location.locationFlags = q.flags[joint];
+        location.radius = DequantizePosition(q.radius[joint]);
+        location.pose.orientation = (q.flags[joint] & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)
+                                        ? UnpackQuaternion(q.orientation[joint]) : QuatIdentity();
+        XrVector3f position{DequantizePosition(q.position[joint][0]),
+                            DequantizePosition(q.position[joint][1]),
+                            DequantizePosition(q.position[joint][2])};
+        if (!(q.flags[joint] & XR_SPACE_LOCATION_POSITION_VALID_BIT)) {
+            position = {0.0f, 0.0f, 0.0f};
+        } else if (q.wristRelative && joint != XR_HAND_JOINT_WRIST_EXT) {
+            position = Add(wrist.position, QuatRotate(wrist.orientation, position));
+        }
+        location.pose.position = position;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Byte I/O
+// ----------------------------------------------------------------------------
+
+class StreamWriter {
+public:
+    StreamWriter(uint8_t* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+    void U8(uint8_t value) {
+        if (m_size < m_capacity) {
+            m_data[m_size] = value;
+        } else {
+            m_overflow = true;
+        }
+        m_size++;
+    }
+    void U16(uint16_t value) { Bytes(value, 2); }
+    void U32(uint32_t value) { Bytes(value, 4); }
+    void U64(uint64_t value) { Bytes(value, 8); }
+    void ZigzagVarint(int32_t value) {
+        uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+        while (zigzag >= 0x80) {
+            U8(static_cast<uint8_t>(zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        U8(static_cast<uint8_t>(zigzag));
+    }
+
+    // Overwrites 4 bytes written earlier (e.g. the joint mask)
+    void PatchU32(size_t offset, uint32_t value) {
+        for (int i = 0; i < 4 && offset + i < m_capacity; ++i) {
+            m_data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    size_t Size() const { return m_size; }
+    bool Overflow() const { return m_overflow; }
+
+private:
+    uint8_t* m_data;
+    size_t m_capacity;
+    size_t m_size = 0;
+    bool m_overflow = false;
+
+    void Bytes(uint64_t value, int count) {
+        for (int i = 0; i < count; ++i) {
+            U8(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+};
+
+class StreamReader {
+public:
+    StreamReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    uint8_t U8() {
+        if (m_offset >= m_size) {
+            m_error = true;
+            return 0;
+        }
+        return m_data[m_offset++];
+    }
+    uint16_t U16() { return static_cast<uint16_t>(Bytes(2)); }
+    uint32_t U32() { return static_cast<uint32_t>(Bytes(4)); }
+    uint64_t U64() { return Bytes(8); }
+    int32_t ZigzagVarint() {
+        uint32_t zigzag = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte = U8();
+            zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+            }
+        }
+        m_error = true;
+        return 0;
+    }
+
+    bool Error() const { return m_error; }
+    bool AtEnd() const { return m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+    bool m_error = false;
+
+    uint64_t Bytes(int count) {
+        uint64_t value = 0;
+        for (int i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(U8()) << (8 * i);
+        }
+        return value;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Encoder / decoder
+// ----------------------------------------------------------------------------
+
+// Turns frames into packets. Keeps the last keyframe as the delta
+// reference; no allocation after construction.
+class HandStreamEncoder {
+public:
+    explicit HandStreamEncoder(uint32_t keyframeInterval = DEFAULT_STREAM_KEYFRAME_INTERVAL)
+        : m_keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1) {}
+
+    // Forces the next packet to be a keyframe (e.g. when a receiver joins)
+    void RequestKeyframe() { m_framesSinceKeyframe = m_keyframeInterval; }
+
+    // Writes one packet for frame into out. Returns its size, or 0 if
+    // capacity was too small (STREAM_MAX_PACKET_SIZE always suffices).
+    size_t Encode(const HandFrame& frame, uint8_t* out, size_t capacity) {
+        const bool keyframe = m_framesSinceKeyframe >= m_keyframeInterval;
+        const uint32_t frameIndex = static_cast<uint32_t>(frame.frameIndex);
+        if (keyframe) {
+            m_keyframeIndex = frameIndex;
+        }
+
+        StreamWriter writer(out, capacity);
+        writer.U16(STREAM_MAGIC);
+        writer.U8(STREAM_VERSION);
+        writer.U8(keyframe ? STREAM_PACKET_KEYFRAME : 0);
+        writer.U32(frameIndex);
+        writer.U32(m_keyframeIndex);
+        writer.U64(static_cast<uint64_t>(frame.sampleTimeNs));
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            QuantizeHand(frame.hands[hand], m_current);
+            EncodeHand(writer, m_current, m_reference[hand], keyframe);
+            if (keyframe) {
+                m_reference[hand] = m_current;
+            }
+        }
+
+        if (writer.Overflow()) {
+            return 0;
+        }
+        m_framesSinceKeyframe = keyframe ? 1 : m_framesSinceKeyframe + 1;
+        (keyframe ? m_keyframeCount : m_deltaCount)++;
+        return writer.Size();
+    }
+
+    uint64_t GetKeyframeCount() const { return m_keyframeCount; }
+    uint64_t GetDeltaCount() const { return m_deltaCount; }
+
+private:
+    uint32_t m_keyframeInterval;
+    uint32_t m_framesSinceKeyframe = UINT32_MAX;
+    uint32_t m_keyframeIndex = 0;
+    uint64_t m_keyframeCount = 0;
+    uint64_t m_deltaCount = 0;
+    QuantizedHand m_reference[HAND_COUNT];
+    QuantizedHand m_current;
+
+    static void EncodeHand(StreamWriter& writer, const QuantizedHand& current, const QuantizedHand& reference, bool keyframe) {
+        const bool delta = !keyframe && reference.located && current.located &&
+                           reference.wristRelative == current.wristRelative;
+        uint8_t handFlags = 0;
+        handFlags |= current.located ? STREAM_HAND_LOCATED : 0;
+        handFlags |= current.active ? STREAM_HAND_ACTIVE : 0;
+        handFlags |= current.wristRelative ? STREAM_HAND_WRIST_RELATIVE : 0;
+        handFlags |= delta ? 0 : STREAM_HAND_FULL;
+        writer.U8(handFlags);
+        if (!current.located) {
+            writer.U32(static_cast<uint32_t>(current.result));
+            return;
+        }
+
+        const size_t maskOffset = writer.Size();
+        writer.U32(0);
+        uint32_t mask = 0;
+
+        for (uint32_t joint = 0; joint < XR_HAND_JOINT_COUNT_EXT; ++joint) {
+            const uint8_t flags = current.flags[joint];
+            bool absolute = !delta || (flags & STREAM_JOINT_VALID_BITS & ~reference.flags[joint]) != 0;
+            bool samePosition = false;
+            bool sameOrientation = false;
+
+            if (absolute) {
+                if ((flags & STREAM_JOINT_VALID_BITS) == 0) {
+                    continue;  // invalid joints are implied by the mask
+                }
+            } else {
+                samePosition = !(flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) ||
+                               std::memcmp(current.position[joint], reference.position[joint], sizeof(current.position[joint])) == 0;
+                sameOrientation = !(flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) ||
+                                  current.orientation[joint] == reference.orientation[joint];
+                if (flags == reference.flags[joint] && samePosition && sameOrientation) {
+                    continue;  // unchanged since the keyframe
+                }
+            }
+
+            mask |= 1u << joint;
+            uint8_t jointFlags = flags;
+            jointFlags |= absolute ? STREAM_JOINT_ABSOLUTE : 0;
+            jointFlags |= (!absolute && samePosition) ? STREAM_JOINT_SAME_POSITION : 0;
+            jointFlags |= (!absolute && sameOrientation) ? STREAM_JOINT_SAME_ORIENTATION : 0;
+            writer.U8(jointFlags);
+
+            if ((flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) && (absolute || !samePosition)) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    int32_t value = current.position[joint][axis];
+                    writer.ZigzagVarint(absolute ? value : value - reference.position[joint][axis]);
+                }
+            }
+            if ((flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) && (absolute || !sameOrientation)) {
+                writer.U32(current.orientation[joint]);
+            }
+            if (absolute) {
+                writer.U16(current.radius[joint]);
+            }
+        }
+        writer.PatchU32(maskOffset, mask);
+    }
+};
+
+enum class StreamDecodeResult {
+    Ok,
+    Malformed,        // bad magic/version or truncated packet
+    MissingKeyframe   // a delta packet whose keyframe was not received
+};
+
+// Turns packets back into frames. Keeps the last received keyframe; delta
+// packets for any other keyframe are rejected until the next one arrives.
+class HandStreamDecoder {
+public:
+    StreamDecodeResult Decode(const uint8_t* data, size_t size, HandFrame& frame) {
+        StreamReader reader(data, size);
+        if (size < STREAM_HEADER_SIZE || reader.U16() != STREAM_MAGIC || reader.U8() != STREAM_VERSION) {
+            return StreamDecodeResult::Malformed;
+        }
+        const bool keyframe = (reader.U8() & STREAM_PACKET_KEYFRAME) != 0;
+        const uint32_t frameIndex = reader.U32();
+        const uint32_t keyframeIndex = reader.U32();
+        const bool haveReference = keyframe || (m_haveKeyframe && keyframeIndex == m_keyframeIndex);
+        frame.frameIndex = frameIndex;
+        frame.sampleTimeNs = static_cast<int64_t>(reader.U64());
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            StreamDecodeResult result = DecodeHand(reader, m_reference[hand], haveReference, m_current[hand]);
+            if (result != StreamDecodeResult::Ok) {
+                return result;
+            }
+        }
+        if (reader.Error() || !reader.AtEnd()) {
+            return StreamDecodeResult::Malformed;
+        }
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            DequantizeHand(m_current[hand], frame.hands[hand]);
+            if (keyframe) {
+                m_reference[hand] = m_current[hand];
+            }
+        }
+        if (keyframe) {
+            m_haveKeyframe = true;
+            m_keyframeIndex = keyframeIndex;
+        }
+        return StreamDecodeResult::Ok;
+    }
+
+private:
+    bool m_haveKeyframe = false;
+    uint32_t m_keyframeIndex = 0;
+    QuantizedHand m_reference[HAND_COUNT];
+    QuantizedHand m_current[HAND_COUNT];
+
+    static StreamDecodeResult DecodeHand(StreamReader& reader, const QuantizedHand& reference, bool haveReference, QuantizedHand& q) {
+        const uint8_t handFlags = reader.U8();
+        const bool full = (handFlags & STREAM_HAND_FULL) != 0;
+        q.located = (handFlags & STREAM_HAND_LOCATED) != 0;
+        q.active = (handFlags & STREAM_HAND_ACTIVE) != 0;
+        q.wristRelative = (handFlags & STREAM_HAND_WRIST_RELATIVE) != 0;
+        if (!q.located) {
+            q.result = static_cast<int32_t>(reader.U32());
+            return StreamDecodeResult::Ok;
+        }
+        q.result = XR_SUCCESS;
+        if (!full && !haveReference) {
+            return StreamDecodeResult::MissingKeyframe;
+        }
+
+        if (full) {
+            std::memset(q.flags, 0, sizeof(q.flags));
+            std::memset(q.position, 0, sizeof(q.position));
+            std::memset(q.orientation, 0, sizeof(q.orientation));
+            std::memset(q.radius, 0, sizeof(q.radius));
+        } else {
+            std::memcpy(q.flags, reference.flags, sizeof(q.flags));
+            std::memcpy(q.position, reference.position, sizeof(q.position));
+            std::memcpy(q.orientation, reference.orientation, sizeof(q.orientation));
+            std::memcpy(q.radius, reference.radius, sizeof(q.radius));
+        }
+
+        const uint32_t mask = reader.U32();
+        for (uint32_t joint = 0; joint < XR_HAND_JOINT_COUNT_EXT; ++joint) {
+            if (!(mask & (1u << joint))) {
+                continue;
+            }
+            const uint8_t jointFlags = reader.U8();
+            const uint8_t flags = jointFlags & STREAM_JOINT_LOCATION_MASK;
+            const bool absolute = (jointFlags & STREAM_JOINT_ABSOLUTE) != 0;
+            if (!absolute && full) {
+                return StreamDecodeResult::Malformed;
+            }
+            q.flags[joint] = flags;
+
+            if ((flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) && (absolute || !(jointFlags & STREAM_JOINT_SAME_POSITION))) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    int32_t value = reader.ZigzagVarint();
+                    q.position[joint][axis] = absolute ? value : reference.position[joint][axis] + value;
+                }
+            }
+            if ((flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) && (absolute || !(jointFlags & STREAM_JOINT_SAME_ORIENTATION))) {
+                q.orientation[joint] = reader.U32();
+            }
+            if (absolute) {
+                q.radius[joint] = reader.U16();
+            }
+        }
+        return reader.Error() ? StreamDecodeResult::Malformed : StreamDecodeResult::Ok;
+    }
+};
@@ -0,0 +1,1530 @@
+#pragma once
+
+#include "openxr_minimal.h"
+#include "sampling_scheduler.h"
+#include "hand_frame.h"
+#include "spsc_ring.h"
+#include "frame_consumer.h"
+#include "frame_recording.h"
+#include "replay_hand_tracker.h"
+#include "synthetic_hand_tracker.h"
+#include "latency_histogram.h"
+#include "async_logger.h"
+#include "shm_publisher.h"
+#include "udp_stream.h"
+#include "xr_time_source.h"
+#include "joint_velocity.h"
+#include "joint_filter.h"
+#include "gesture_engine.h"
+#include "core_probe.h"
+#include "startup_timer.h"
+#include "xr_session_state.h"
+#include "metrics.h"
+#include "metrics_server.h"
+#include "triple_buffer.h"
+#include "realtime.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <exception>
+#include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <csignal>
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+// Set the target Manus Core IP address here (override with --core; several
+// targets can be given and the first one to answer is used)
+const std::string TARGET_MANUS_CORE_IP = "172.16.25.99";
+
+// Optional: Set a custom name for the target (for display purposes only)
+const std::string TARGET_MANUS_CORE_NAME = "Target Manus Core";
+
+// TCP port probed on each target before connecting, for targets given
+// without a port (override with --core-port)
+const uint16_t DEFAULT_MANUS_CORE_PROBE_PORT = 9004;
+
+// How long the probe waits for any target to answer (override with
+// --core-probe-ms; 0 connects to the first target without probing)
+const int DEFAULT_CORE_PROBE_TIMEOUT_MS = 500;
+
+// Default sampling rate of the tracking loop (override with --rate <hz>)
+const double DEFAULT_SAMPLE_RATE_HZ = 20.0;
+
+// How long before each deadline the sampling loop stops sleeping and spins
+// (override with --spin-us <microseconds>)
+const int DEFAULT_SPIN_TAIL_US = 200;
+
+// Number of frames buffered between the sampler thread and each consumer
+// (override with --ring-size <frames>)
+const size_t DEFAULT_FRAME_RING_CAPACITY = 1024;
+
+// Largest accepted --predict-ms; runtimes only predict a short way ahead
+const double MAX_PREDICTION_OFFSET_MS = 500.0;
+// ============================================================================
+
+// Runtime options, filled in from the command line
+struct AppConfig {
+    std::vector<std::string> coreTargets{TARGET_MANUS_CORE_IP};  // host[:port], in order of preference
+    uint16_t coreProbePort = DEFAULT_MANUS_CORE_PROBE_PORT;
+    int coreProbeTimeoutMs = DEFAULT_CORE_PROBE_TIMEOUT_MS;
+    double sampleRateHz = DEFAULT_SAMPLE_RATE_HZ;
+    int spinTailUs = DEFAULT_SPIN_TAIL_US;
+    size_t frameRingCapacity = DEFAULT_FRAME_RING_CAPACITY;
+    OverflowPolicy overflowPolicy = OverflowPolicy::DropOldest;
+    std::string recordPath;  // binary recording of every frame, empty = off
+    std::string replayPath;  // serve frames from a recording instead of the runtime
+    bool replayFast = false; // advance one recorded frame per sample instead of following recorded time
+    bool replayLoop = false;
+    bool synthetic = false;  // serve procedural hand data instead of the runtime
+    LogLevel verbosity = LogLevel::Joints;
+    std::string logPath;     // tracking log destination, empty = stdout
+    std::string shmName;     // POSIX shared-memory name to publish frames under, empty = off
+    std::string streamDestination;  // host:port to stream encoded frames to over UDP, empty = off
+    uint32_t streamKeyframeInterval = DEFAULT_STREAM_KEYFRAME_INTERVAL;
+    int64_t predictionOffsetNs = 0;  // locate joints this far past the sample time
+    FilterMode filterMode = FilterMode::Off;  // joint pose filtering on the sampler thread
+    JointFilterParams filterParams[JOINT_GROUP_COUNT];
+    bool gestures = false;           // detect gestures on the sampler thread and log them
+    GestureThresholds gestureThresholds;
+    std::string gestureDestination;  // host:port to send gesture events to over UDP, empty = off
+    std::string metricsAddress;      // [host:]port of the Prometheus endpoint, empty = off
+    RealtimeConfig realtime;         // CPU pinning, SCHED_FIFO and locked memory for the sampler
+};
+
+// Called on the sampler thread with every finished frame
+using FrameCallback = void (*)(const HandFrame& frame, void* userData);
+
+// Simple hand tracking only application
+class HandTrackingOnlyApp {
+public:
+    explicit HandTrackingOnlyApp(const AppConfig& config)
+        : m_config(config), m_logger(config.verbosity) {
+        m_samplerLog = m_logger.CreateChannel(LOG_CHANNEL_CAPACITY);
+        m_jointFilter.Configure(config.filterMode, config.filterParams);
+        m_gestureEngine.Configure(config.gestureThresholds);
+        m_metricsEnabled = !config.metricsAddress.empty();
+    }
+
+    bool Initialize() {
+        if (!m_config.logPath.empty() && !m_logger.OpenFile(m_config.logPath)) {
+            return false;
+        }
+        m_logger.Start();
+        
+        std::cout << "Hand Tracking Only Application" << std::endl;
+        std::cout << "===============================" << std::endl;
+        std::cout << "Target Manus Core IP: " << CoreTargetList() << std::endl;
+        std::cout << "Sample rate: ";
+        if (m_config.sampleRateHz > 0.0) {
+            std::cout << m_config.sampleRateHz << " Hz";
+        } else {
+            std::cout << "free-running";
+        }
+        std::cout << " (spin tail " << m_config.spinTailUs << " us)" << std::endl;
+        if (m_config.predictionOffsetNs != 0) {
+            std::cout << "Prediction offset: " << m_config.predictionOffsetNs / 1e6 << " ms" << std::endl;
+        }
+        if (m_jointFilter.IsEnabled()) {
+            std::cout << "Joint filter: " << FilterModeName(m_jointFilter.GetMode()) << std::endl;
+        }
+        if (m_config.gestures) {
+            std::cout << "Gesture detection: on (debounce " << m_config.gestureThresholds.debounceMs << " ms)" << std::endl;
+        }
+        if (m_config.realtime.enabled) {
+            std::cout << "Real-time sampler: CPU ";
+            if (m_config.realtime.cpu >= 0) {
+                std::cout << m_config.realtime.cpu;
+            } else {
+                std::cout << LastAllowedCpu() << " (last allowed)";
+            }
+            std::cout << ", SCHED_FIFO priority " << m_config.realtime.priority << ", locked memory" << std::endl;
+        }
+        std::cout << "===============================" << std::endl;
+        
+        // Replay and synthetic data bypass the runtime entirely
+        if (!m_config.replayPath.empty() || m_config.synthetic) {
+            bool initialized = m_startup.Run("stand-in", [this] { return InitializeStandIn(); }) &&
+                               m_startup.Run("hand trackers", [this] { return CreateHandTrackers(); });
+            m_startup.Print(std::cout);
+            return initialized;
+        }
+        
+        // The Core probe runs in the background while the instance and
+        // system are created
+        if (m_config.coreProbeTimeoutMs > 0 && !m_config.coreTargets.empty()) {
+            m_coreProber.Start(m_config.coreTargets, m_config.coreProbePort,
+                               std::chrono::milliseconds(m_config.coreProbeTimeoutMs));
+        }
+        
+        bool initialized = m_startup.Run("instance", [this] { return CreateInstance(); }) &&
+                           m_startup.Run("system", [this] { return GetSystem(); }) &&
+                           m_startup.Run("hand tracking + core connection", [this] { return InitializeHandTracking(); }) &&
+                           m_startup.Run("session", [this] { return CreateSimpleSession(); }) &&
+                           m_startup.Run("hand trackers", [this] { return CreateHandTrackers(); });
+        m_startup.Print(std::cout);
+        if (!initialized) {
+            return false;
+        }
+        
+        // Now document the Manus connections we can see
+        std::cout << "=== MANUS CORE CONNECTION STATUS ===" << std::endl;
+        std::cout << "Target IP: " << CoreTargetList() << " (" << TARGET_MANUS_CORE_NAME << ")" << std::endl;
+        std::cout << "Selected Core: " << (m_selectedCore.empty() ? "none (auto-discovery)" : m_selectedCore) << std::endl;
+        std::cout << "Remote connection function: " << (m_xrConnectToRemoteMANUSCore ? "Available" : "Not available") << std::endl;
+        std::cout << "Note: Manus SDK appears to be auto-discovering and connecting to available cores" << std::endl;
+        std::cout << "Check the logs above for 'Client) Got availability response' messages" << std::endl;
+        std::cout << "====================================" << std::endl;
+        
+        // Skip the direct function call for now to avoid crashes
+        // TODO: Investigate correct function signature and calling context
+        /*
+        if (m_xrConnectToRemoteMANUSCore != nullptr) {
+            std::cout << "Attempting to connect to specific Manus Core at " << TARGET_MANUS_CORE_IP << "..." << std::endl;
+            
+            try {
+                XrResult result = m_xrConnectToRemoteMANUSCore(TARGET_MANUS_CORE_IP);
+                if (XR_SUCCEEDED(result)) {
+                    std::cout << "✅ Successfully connected to remote Manus Core at " << TARGET_MANUS_CORE_IP << "!" << std::endl;
+                } else {
+                    std::cout << "⚠️  Failed to connect to remote Manus Core at " << TARGET_MANUS_CORE_IP << " (result: " << result << ")" << std::endl;
+                    std::cout << "   Continuing with default/auto-discovery connection..." << std::endl;
+                }
+            } catch (...) {
+                std::cout << "⚠️  Exception occurred while connecting to remote Manus Core" << std::endl;
+                std::cout << "   Continuing with default connection..." << std::endl;
+            }
+        } else {
+            std::cout << "Using default Manus Core connection (auto-discovery)" << std::endl;
+        }
+        */
+        
+        return true;
+    }
+    
+    // Starts the consumers and, for stand-in sources, the sampler; a
+    // runtime session starts sampling once it is READY. A session ended by
+    // an earlier Run() is recreated first. Returns false (with everything
+    // stopped again) if something could not be started.
+    bool Start() {
+        std::cout << "Starting continuous hand tracking loop..." << std::endl;
+        std::cout << "======================================" << std::endl;
+        m_exitRequested = false;
+        
+        if (!m_standIn && m_instance != XR_NULL_HANDLE && m_session == XR_NULL_HANDLE &&
+            !(CreateSimpleSession() && CreateHandTrackers())) {
+            DestroySession();
+            return false;
+        }
+        
+        if (!m_config.recordPath.empty() && !StartRecorder()) {
+            return false;
+        }
+        
+        if (!m_config.streamDestination.empty() && !StartStreamer()) {
+            StopRecorder();
+            return false;
+        }
+        
+        if (!m_config.gestureDestination.empty() && !StartEventSender()) {
+            StopRecorder();
+            StopStreamer();
+            return false;
+        }
+        
+        if (!m_config.shmName.empty()) {
+            if (!m_shmPublisher.Open(m_config.shmName, m_config.sampleRateHz)) {
+                StopRecorder();
+                StopStreamer();
+                StopEventSender();
+                return false;
+            }
+            std::cout << "Publishing frames to shared memory " << m_config.shmName << std::endl;
+        }
+        
+        if (m_metricsEnabled) {
+            if (!m_metricsServer.Start(m_config.metricsAddress, [this](std::string& out) { WriteMetrics(out); })) {
+                StopRecorder();
+                StopStreamer();
+                StopEventSender();
+                m_shmPublisher.Close();
+                return false;
+            }
+            std::cout << "Serving metrics at http://" << m_metricsServer.GetAddress() << "/metrics" << std::endl;
+        }
+        
+        // Locked after the consumers so their buffers are locked too
+        if (m_config.realtime.enabled) {
+            m_memoryLockError = LockProcessMemory();
+        }
+        
+        if (m_standIn) {
+            StartSampler();
+        }
+        return true;
+    }
+    
+    // After a successful Start(): polls session events and prints status
+    // until RequestStop() (from any thread) or until the session or
+    // stand-in source ends, then stops everything Start() started. The
+    // instance stays, so Start() and Run() may follow again.
+    void Run() {
+        bool manusConnectionLogged = false;
+        bool firstValidFrameLogged = false;
+        auto lastStatusTime = std::chrono::steady_clock::now();
+        
+        while (!m_stopRequested.load()) {
+            PollEvents();
+            if (m_sessionLost.load(std::memory_order_relaxed)) {
+                HandleSessionLoss("locate call reported XR_ERROR_SESSION_LOST");
+            }
+            if (m_recovering) {
+                TryRecoverSession();
+            }
+            
+            if (m_standIn && m_standIn->IsFinished()) {
+                std::cout << "Stand-in source (" << m_standIn->Name() << ") has no more data" << std::endl;
+                break;
+            }
+            
+            if (m_realtimeStatusReady.exchange(false, std::memory_order_acquire)) {
+                PrintRealtimeStatus(std::cout, m_realtimeStatus, m_memoryLockError);
+            }
+            
+            if (!firstValidFrameLogged && m_startup.HasFirstValidFrame()) {
+                std::cout << "[Status] First valid frame " << std::fixed << std::setprecision(1)
+                          << m_startup.FirstValidFrameMs() << " ms after start" << std::defaultfloat << std::endl;
+                firstValidFrameLogged = true;
+            }
+            
+            // Log Manus connection details once after a few frames
+            if (!m_standIn && !manusConnectionLogged && m_samplerFrameCount.load() >= 50) {
+                std::cout << "\n=== MANUS CONNECTION ANALYSIS ===" << std::endl;
+                std::cout << "Based on the logs above, check for:" << std::endl;
+                std::cout << "- Lines containing 'CoreSdkWrapper_UnrecognizedClient_XXXXX is connecting to'" << std::endl;
+                std::cout << "- Look for target IP " << (m_selectedCore.empty() ? CoreTargetList() : m_selectedCore) << " in the connection logs" << std::endl;
+                std::cout << "- The 'Connected:' message shows successful connection details" << std::endl;
+                std::cout << "=================================\n" << std::endl;
+                manusConnectionLogged = true;
+            }
+            
+            // Log sampling statistics every 5 seconds
+            auto currentTime = std::chrono::steady_clock::now();
+            if (m_samplerStatsReady.load(std::memory_order_acquire)) {
+                // Copy both before handing the slot back to the sampler
+                SamplingScheduler::Stats stats = m_samplerStats;
+                JointFilter::Stats filter = m_filterStats;
+                m_samplerStatsReady.store(false, std::memory_order_release);
+                RecordIntervalMetrics(stats);
+                // Here rather than on the sampler, which makes no runtime
+                // calls besides locating
+                m_timeSource.Calibrate();
+                
+                std::cout << "[Status] Frame " << m_samplerFrameCount.load()
+                          << " - " << std::fixed << std::setprecision(1) << stats.AchievedRate() << " Hz";
+                if (m_config.sampleRateHz > 0.0) {
+                    std::cout << " (target " << m_config.sampleRateHz << " Hz)";
+                }
+                std::cout << ", jitter mean/rms/max " << std::setprecision(1)
+                          << stats.jitterMeanUs << "/" << stats.jitterRmsUs << "/" << stats.jitterMaxUs << " us"
+                          << ", overruns " << stats.overruns
+                          << ", skipped ticks " << stats.skippedTicks
+                          << std::defaultfloat << std::endl;
+                std::cout << "[Status] Log: " << m_logger.GetWrittenCount() << " records written, "
+                          << m_logger.GetDroppedCount() << " dropped" << std::endl;
+                PrintDeliveryLatency();
+                if (m_jointFilter.IsEnabled()) {
+                    double reduction = filter.FilteredJitterM() > 0.0 ? filter.RawJitterM() / filter.FilteredJitterM() : 0.0;
+                    std::cout << "[Status] Filter (" << FilterModeName(m_jointFilter.GetMode()) << "): jitter "
+                              << std::fixed << std::setprecision(3) << filter.RawJitterM() * 1000.0 << " -> "
+                              << filter.FilteredJitterM() * 1000.0 << " mm (" << std::setprecision(1) << reduction
+                              << "x less), " << filter.MeanNs() / 1000.0 << " us/frame mean, "
+                              << filter.maxNs / 1000.0 << " us max" << std::defaultfloat << std::endl;
+                }
+                if (m_recorderThread) {
+                    std::cout << "[Status] Recording: " << m_recorder.GetFramesWritten() << " frames, "
+                              << std::fixed << std::setprecision(1) << m_recorder.GetBytesWritten() / (1024.0 * 1024.0)
+                              << " MiB written, " << m_recorderThread->Ring().GetDroppedCount() << " dropped"
+                              << std::defaultfloat << std::endl;
+                }
+                if (m_streamerThread) {
+                    uint64_t packets = m_streamer.GetPacketsSent();
+                    std::cout << "[Status] Stream: " << packets << " packets, "
+                              << std::fixed << std::setprecision(1)
+                              << (packets ? static_cast<double>(m_streamer.GetBytesSent()) / packets : 0.0)
+                              << " bytes/frame, " << m_streamer.GetSendErrors() << " send errors, "
+                              << m_streamerThread->Ring().GetDroppedCount() << " dropped"
+                              << std::defaultfloat << std::endl;
+                }
+                if (m_config.gestures) {
+                    std::cout << "[Status] Gestures: " << m_gestureEngine.GetEventCount() << " events";
+                    if (m_eventSenderThread) {
+                        std::cout << ", " << m_eventSender.GetEventsSent() << " sent, "
+                                  << m_eventSender.GetSendErrors() << " send errors, "
+                                  << m_eventSenderThread->Ring().GetDroppedCount() << " dropped";
+                    }
+                    std::cout << std::endl;
+                }
+                if (m_shmPublisher.IsOpen()) {
+                    std::cout << "[Status] Shared memory: " << m_shmPublisher.GetPublishedCount() << " frames published" << std::endl;
+                }
+                lastStatusTime = currentTime;
+            } else if (!m_handTrackingSupported && currentTime - lastStatusTime >= STATUS_LOG_PERIOD) {
+                std::cout << "[Status] Hand tracking not supported - waiting for events" << std::endl;
+                lastStatusTime = currentTime;
+            } else if (!m_standIn && !m_sessionRunning && currentTime - lastStatusTime >= STATUS_LOG_PERIOD) {
+                std::cout << "[Status] Session " << (m_recovering ? "lost, recreating" : SessionStateName(m_sessionState))
+                          << " - not sampling (" << m_sessionRecoveries << " recoveries so far)" << std::endl;
+                lastStatusTime = currentTime;
+            }
+            
+            std::this_thread::sleep_for(EVENT_POLL_PERIOD);
+        }
+        
+        std::cout << "Stopping hand tracking loop..." << std::endl;
+        Stop();
+    }
+    
+    // Stops everything Start() started; Run() ends with it, and it undoes a
+    // Start() that is not followed by Run()
+    void Stop() {
+        // The endpoint reads the consumers, so it goes first
+        m_metricsServer.Stop();
+        ExitSession();
+        StopSampler();
+        StopRecorder();
+        StopStreamer();
+        StopEventSender();
+        m_shmPublisher.Close();
+        // An exited session cannot be begun again; the next Start()
+        // creates a new one
+        if (!m_standIn) {
+            DestroySession();
+            m_recovering = false;
+        }
+        if (m_config.realtime.enabled && m_memoryLockError == 0) {
+            UnlockProcessMemory();
+        }
+    }
+    
+    // Leaves Run(); safe from any thread, but not from a signal handler
+    // that interrupted Run() itself (use an atomic flag there)
+    void RequestStop() {
+        m_stopRequested.store(true);
+    }
+    
+    // Before the next Start()
+    void ClearStopRequest() {
+        m_stopRequested.store(false);
+    }
+    
+    // Only while the sampler is stopped (before Start() or after Run())
+    void SetFrameCallback(FrameCallback callback, void* userData) {
+        m_frameCallback = callback;
+        m_frameCallbackUserData = userData;
+    }
+    
+    // The newest finished frame, without copying, or nullptr before the
+    // first one. Valid until the next call; one reading thread at a time.
+    const HandFrame* ReadLatestFrame() {
+        return m_latestFrame.ReadLatest();
+    }
+    
+    void Shutdown() {
+        m_metricsServer.Stop();
+        StopSampler();
+        StopRecorder();
+        StopStreamer();
+        StopEventSender();
+        m_shmPublisher.Close();
+        m_logger.Stop();
+        
+        DestroySession();
+        if (m_instance != XR_NULL_HANDLE) {
+            xrDestroyInstance(m_instance);
+            m_instance = XR_NULL_HANDLE;
+        }
+    }
+
+private:
+    static constexpr std::chrono::seconds STATUS_LOG_PERIOD{5};
+    static constexpr std::chrono::seconds DETAIL_LOG_PERIOD{2};
+    static constexpr std::chrono::milliseconds PALM_LOG_PERIOD{500};
+    static constexpr std::chrono::milliseconds EVENT_POLL_PERIOD{5};
+    static constexpr size_t LOG_CHANNEL_CAPACITY = 4096;
+    static constexpr size_t EVENT_RING_CAPACITY = 256;
+    static constexpr std::chrono::milliseconds FIRST_RECOVERY_DELAY{100};
+    static constexpr std::chrono::milliseconds MAX_RECOVERY_DELAY{5000};
+    static constexpr std::chrono::milliseconds EXIT_SESSION_TIMEOUT{1000};
+    
+    AppConfig m_config;
+    std::atomic<bool> m_stopRequested{false};
+    
+    // Startup phase timings and time to the first valid frame
+    StartupTimer m_startup;
+    
+    // Background reachability check of the Core targets, and the one connected to
+    CoreProber m_coreProber;
+    std::string m_selectedCore;
+    
+    // Sampler thread and the consumers it feeds (one ring each)
+    std::thread m_samplerThread;
+    std::atomic<bool> m_samplerRunning{false};
+    std::atomic<uint64_t> m_samplerFrameCount{0};
+    std::vector<FrameConsumerThread*> m_consumers;
+    
+    // Tracking log: the sampler writes binary records, the logger thread formats them
+    AsyncLogger m_logger;
+    AsyncLogger::Channel* m_samplerLog = nullptr;
+    
+    // Binary recorder, fed through its own ring and thread
+    RecordingWriter m_recorder;
+    uint32_t m_recordRuns = 0;  // Start() calls that opened a recording
+    std::unique_ptr<FrameConsumerThread> m_recorderThread;
+    
+    // UDP stream encoder/sender, fed through its own ring and thread
+    UdpStreamSender m_streamer;
+    std::unique_ptr<FrameConsumerThread> m_streamerThread;
+    
+    // Gesture event sender, fed through its own (small) ring and thread
+    UdpEventSender m_eventSender;
+    std::unique_ptr<ConsumerThread<GestureEvent>> m_eventSenderThread;
+    
+    // Latest frame and short history for local readers, written by the sampler
+    ShmPublisher m_shmPublisher;
+    
+    // In-process subscribers: a per-frame callback on the sampler thread,
+    // and the latest frame for pulling. The sampler builds each frame in
+    // place in the triple buffer.
+    FrameCallback m_frameCallback = nullptr;
+    void* m_frameCallbackUserData = nullptr;
+    TripleBuffer<HandFrame> m_latestFrame;
+    
+    // Consumer latency report being printed (main thread)
+    LatencyHistogram m_statusLatency;
+    
+    // Single-slot hand-off of scheduler statistics to the status line
+    SamplingScheduler::Stats m_samplerStats;
+    JointFilter::Stats m_filterStats;
+    std::atomic<bool> m_samplerStatsReady{false};
+    
+    // Counters behind the metrics endpoint; only recorded when it is on
+    bool m_metricsEnabled = false;
+    TrackingMetrics m_metrics;
+    MetricsServer m_metricsServer;
+    
+    // Real-time mode: the sampler applies it to itself and hands the
+    // outcome to the main thread to print
+    int m_memoryLockError = 0;
+    RealtimeStatus m_realtimeStatus;
+    std::atomic<bool> m_realtimeStatusReady{false};
+    
+    // Frame log state (sampler thread)
+    bool m_lastHandActive[HAND_COUNT] = {false, false};
+    int64_t m_nextDetailLogNs = 0;
+    int64_t m_nextPalmLogNs = 0;
+    
+    // Session lifecycle (main thread, except m_sessionLost which the
+    // sampler sets when a locate call reports the session lost)
+    XrSessionState m_sessionState = XR_SESSION_STATE_UNKNOWN;
+    bool m_sessionRunning = false;
+    bool m_exitRequested = false;
+    std::atomic<bool> m_sessionLost{false};
+    bool m_recovering = false;
+    uint32_t m_recoveryAttempts = 0;
+    uint64_t m_sessionRecoveries = 0;
+    std::chrono::milliseconds m_recoveryDelay{FIRST_RECOVERY_DELAY};
+    std::chrono::steady_clock::time_point m_lossTime;
+    std::chrono::steady_clock::time_point m_nextRecoveryAttempt;
+    std::chrono::steady_clock::time_point m_readyTime;
+    
+    XrInstance m_instance = XR_NULL_HANDLE;
+    XrSystemId m_systemId = XR_NULL_SYSTEM_ID;
+    XrSession m_session = XR_NULL_HANDLE;
+    XrSpace m_appSpace = XR_NULL_HANDLE;
+    
+    bool m_handTrackingSupported = false;
+    XrHandTrackerEXT m_handTrackers[2] = {XR_NULL_HANDLE, XR_NULL_HANDLE};
+    
+    // Manus-specific function pointers
+    PFN_xrCreateHandTrackerEXT m_xrCreateHandTrackerEXT = nullptr;
+    PFN_xrDestroyHandTrackerEXT m_xrDestroyHandTrackerEXT = nullptr;
+    PFN_xrLocateHandJointsEXT m_xrLocateHandJointsEXT = nullptr;
+    
+    // Manus remote connection function pointer
+    typedef XrResult (*PFN_xrConnectToRemoteMANUSCore)(std::string);
+    
+    PFN_xrConnectToRemoteMANUSCore m_xrConnectToRemoteMANUSCore = nullptr;
+    
+    // Monotonic clock <-> XrTime (converted on the sampler thread,
+    // recalibrated on the main thread)
+    XrTimeSource m_timeSource;
+    
+    // Fallback joint velocities (sampler thread); the scratch array takes
+    // the unused estimate while the runtime provides velocities
+    JointVelocityEstimator m_velocityEstimator;
+    XrHandJointVelocityEXT m_estimatedVelocities[XR_HAND_JOINT_COUNT_EXT];
+    
+    // Joint pose filter (sampler thread)
+    JointFilter m_jointFilter;
+    
+    // Gesture detection and its per-frame output (sampler thread)
+    GestureEngine m_gestureEngine;
+    GestureEvent m_gestureEvents[GestureEngine::MAX_EVENTS_PER_FRAME];
+    
+    // In-process replacement for the runtime's hand tracking (replay or synthetic)
+    std::unique_ptr<StandInHandTracker> m_standIn;
+    
+    bool InitializeStandIn() {
+        if (!m_config.replayPath.empty()) {
+            auto replay = std::make_unique<ReplayHandTracker>();
+            if (!replay->Open(m_config.replayPath, m_config.replayFast, m_config.replayLoop)) {
+                return false;
+            }
+            std::cout << "Replaying " << m_config.replayPath << ": " << replay->FrameCount() << " frames, "
+                      << replay->DurationSeconds() << " s, recorded at " << replay->RecordedRate() << " Hz ("
+                      << (m_config.replayFast ? "one frame per sample" : "original timing")
+                      << (m_config.replayLoop ? ", looping" : "") << ")" << std::endl;
+            m_standIn = std::move(replay);
+        } else {
+            std::cout << "Using synthetic hand data" << std::endl;
+            m_standIn = std::make_unique<SyntheticHandTracker>();
+        }
+        
+        m_xrCreateHandTrackerEXT = &StandInHandTracker::CreateHandTracker;
+        m_xrDestroyHandTrackerEXT = &StandInHandTracker::DestroyHandTracker;
+        m_xrLocateHandJointsEXT = &StandInHandTracker::LocateHandJoints;
+        m_handTrackingSupported = true;
+        return true;
+    }
+    
+    bool CreateInstance() {
+        // Enumerate extensions
+        uint32_t extensionCount;
+        xrEnumerateInstanceExtensionProperties(nullptr, 0, &extensionCount, nullptr);
+        std::vector<XrExtensionProperties> availableExtensions(extensionCount,
+                                                              {XR_TYPE_EXTENSION_PROPERTIES});
+        xrEnumerateInstanceExtensionProperties(nullptr, extensionCount, &extensionCount,
+                                             availableExtensions.data());
+
+        // Check for required extensions
+        bool hasHandTracking = false;
+        bool hasHeadless = false;
+        bool hasConvertTimespec = false;
+        
+        for (const auto& ext : availableExtensions) {
+            if (strcmp(ext.extensionName, XR_EXT_HAND_TRACKING_EXTENSION_NAME) == 0) {
+                hasHandTracking = true;
+            }
+            if (strcmp(ext.extensionName, "XR_MND_headless") == 0) {
+                hasHeadless = true;
+            }
+            if (strcmp(ext.extensionName, XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME) == 0) {
+                hasConvertTimespec = true;
+            }
+        }
+        
+        std::vector<const char*> extensions;
+        if (hasHeadless) {
+            extensions.push_back("XR_MND_headless");
+            std::cout << "Using headless mode" << std::endl;
+        }
+        if (hasHandTracking) {
+            extensions.push_back(XR_EXT_HAND_TRACKING_EXTENSION_NAME);
+            m_handTrackingSupported = true;
+            std::cout << "Hand tracking available" << std::endl;
+        }
+        if (hasConvertTimespec) {
+            extensions.push_back(XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME);
+        }
+        
+        XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.enabledExtensionNames = extensions.data();
+        strcpy(createInfo.applicationInfo.applicationName, "Hand Tracking Only");
+        createInfo.applicationInfo.applicationVersion = 1;
+        strcpy(createInfo.applicationInfo.engineName, "Simple Engine");
+        createInfo.applicationInfo.engineVersion = 1;
+        createInfo.applicationInfo.apiVersion = XR_MAKE_VERSION(1, 0, 0);
+
+        XrResult result = xrCreateInstance(&createInfo, &m_instance);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to create OpenXR instance" << std::endl;
+            return false;
+        }
+        
+        std::cout << "OpenXR instance created successfully" << std::endl;
+        
+        m_timeSource.Initialize(m_instance, hasConvertTimespec);
+        if (m_timeSource.IsRuntimeClock()) {
+            std::cout << "Sample times converted to XrTime with " << XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME << std::endl;
+        } else {
+            std::cout << "Warning: " << XR_KHR_CONVERT_TIMESPEC_TIME_EXTENSION_NAME
+                      << " not available - assuming XrTime is CLOCK_MONOTONIC" << std::endl;
+        }
+        return true;
+    }
+    
+    bool GetSystem() {
+        XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+        systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+
+        XrResult result = xrGetSystem(m_instance, &systemInfo, &m_systemId);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to get system" << std::endl;
+            return false;
+        }
+        
+        std::cout << "OpenXR system obtained" << std::endl;
+        return true;
+    }
+    
+    bool InitializeHandTracking() {
+        if (!m_handTrackingSupported) {
+            std::cout << "Hand tracking not supported" << std::endl;
+            return true;
+        }
+        
+        // Get standard OpenXR hand tracking function pointers
+        XrResult result = xrGetInstanceProcAddr(m_instance, "xrCreateHandTrackerEXT",
+                                              (PFN_xrVoidFunction*)&m_xrCreateHandTrackerEXT);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to get xrCreateHandTrackerEXT" << std::endl;
+            return false;
+        }
+
+        result = xrGetInstanceProcAddr(m_instance, "xrDestroyHandTrackerEXT",
+                                     (PFN_xrVoidFunction*)&m_xrDestroyHandTrackerEXT);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to get xrDestroyHandTrackerEXT" << std::endl;
+            return false;
+        }
+
+        result = xrGetInstanceProcAddr(m_instance, "xrLocateHandJointsEXT",
+                                     (PFN_xrVoidFunction*)&m_xrLocateHandJointsEXT);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to get xrLocateHandJointsEXT" << std::endl;
+            return false;
+        }
+        
+        // Get Manus-specific remote connection function pointer
+        result = xrGetInstanceProcAddr(m_instance, "xrConnectToRemoteMANUSCore",
+                                     (PFN_xrVoidFunction*)&m_xrConnectToRemoteMANUSCore);
+        if (XR_FAILED(result)) {
+            std::cout << "Warning: Failed to get xrConnectToRemoteMANUSCore function - using default connection" << std::endl;
+            m_xrConnectToRemoteMANUSCore = nullptr;
+        } else {
+            std::cout << "Manus remote connection function obtained - attempting immediate connection" << std::endl;
+            ConnectToCore();
+        }
+        
+        std::cout << "Hand tracking function pointers obtained" << std::endl;
+        return true;
+    }
+    
+    std::string CoreTargetList() const {
+        std::string list;
+        for (const std::string& target : m_config.coreTargets) {
+            list += (list.empty() ? "" : ", ") + target;
+        }
+        return list.empty() ? "none" : list;
+    }
+    
+    // Connects the Manus layer to the first target that answered the probe,
+    // or to the first target when probing is off. With no reachable target
+    // the blocking connect call is skipped and the layer's auto-discovery
+    // takes over.
+    void ConnectToCore() {
+        std::string target;
+        if (m_config.coreProbeTimeoutMs > 0) {
+            int selected = m_coreProber.Wait();
+            std::cout << "Core probe (port " << m_config.coreProbePort << " unless given, "
+                      << m_config.coreProbeTimeoutMs << " ms timeout):" << std::endl;
+            for (const CoreProbeResult& result : m_coreProber.GetResults()) {
+                std::cout << "  " << result.target << ": " << (result.reachable ? "reachable" : result.error)
+                          << " (" << std::fixed << std::setprecision(1) << result.elapsedMs << " ms)"
+                          << std::defaultfloat << std::endl;
+            }
+            if (selected < 0) {
+                std::cout << "No target Manus Core answered - using default/auto-discovery connection" << std::endl;
+                return;
+            }
+            target = m_coreProber.GetResults()[selected].target;
+        } else if (!m_config.coreTargets.empty()) {
+            target = m_config.coreTargets.front();
+        } else {
+            return;
+        }
+        
+        std::string host = CoreTargetHost(target);
+        std::cout << "\n=== ATTEMPTING REMOTE CONNECTION (EARLY) ===" << std::endl;
+        std::cout << "Connecting to target IP: " << host << std::endl;
+        
+        auto connectStart = std::chrono::steady_clock::now();
+        try {
+            XrResult connectResult = m_xrConnectToRemoteMANUSCore(host);
+            if (XR_SUCCEEDED(connectResult)) {
+                std::cout << "✅ Successfully connected to remote Manus Core at " << host << "!" << std::endl;
+                m_selectedCore = host;
+            } else {
+                std::cout << "⚠️ Remote connection returned: " << connectResult << " (0x" << std::hex << connectResult << std::dec << ")" << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "❌ Exception during remote connection: " << e.what() << std::endl;
+        } catch (...) {
+            std::cout << "❌ Unknown exception during remote connection" << std::endl;
+        }
+        
+        std::cout << "=== REMOTE CONNECTION ATTEMPT COMPLETED ("
+                  << std::fixed << std::setprecision(1)
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - connectStart).count()
+                  << " ms) ===" << std::defaultfloat << std::endl;
+    }
+    
+    bool CreateSimpleSession() {
+        XrSessionCreateInfo sessionInfo{XR_TYPE_SESSION_CREATE_INFO};
+        sessionInfo.systemId = m_systemId;
+        // No graphics binding for headless mode
+
+        XrResult result = xrCreateSession(m_instance, &sessionInfo, &m_session);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to create session" << std::endl;
+            return false;
+        }
+
+        // Create reference space
+        XrReferenceSpaceCreateInfo spaceInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+        spaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+        spaceInfo.poseInReferenceSpace = {{0, 0, 0, 1}, {0, 0, 0}};
+
+        result = xrCreateReferenceSpace(m_session, &spaceInfo, &m_appSpace);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to create reference space" << std::endl;
+            return false;
+        }
+        
+        std::cout << "Session and reference space created" << std::endl;
+        return true;
+    }
+    
+    bool CreateHandTrackers() {
+        if (!m_handTrackingSupported) {
+            return true;
+        }
+        
+        // Create hand trackers for left and right hands
+        for (int hand = 0; hand < 2; ++hand) {
+            XrHandTrackerCreateInfoEXT createInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+            createInfo.hand = (hand == 0) ? XR_HAND_LEFT_EXT : XR_HAND_RIGHT_EXT;
+            createInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+
+            XrSession session = m_standIn ? m_standIn->SessionHandle() : m_session;
+            XrResult result = m_xrCreateHandTrackerEXT(session, &createInfo, &m_handTrackers[hand]);
+            if (XR_FAILED(result)) {
+                std::cerr << "Failed to create hand tracker for " 
+                          << (hand == 0 ? "left" : "right") << " hand" << std::endl;
+                return false;
+            }
+        }
+        
+        std::cout << "Hand trackers created for both hands" << std::endl;
+
+        return true;
+    }
+    
+    void PollEvents() {
+        XrEventDataBuffer eventData{XR_TYPE_EVENT_DATA_BUFFER};
+        while (m_instance != XR_NULL_HANDLE && xrPollEvent(m_instance, &eventData) == XR_SUCCESS) {
+            if (eventData.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+                const XrEventDataSessionStateChanged* stateEvent =
+                    reinterpret_cast<const XrEventDataSessionStateChanged*>(&eventData);
+                // Late events of a session that was already destroyed
+                if (stateEvent->session == m_session) {
+                    HandleSessionStateChange(stateEvent->state);
+                }
+            } else if (eventData.type == XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING) {
+                std::cerr << "OpenXR instance loss pending - exiting" << std::endl;
+                m_stopRequested.store(true);
+            }
+            eventData = XrEventDataBuffer{XR_TYPE_EVENT_DATA_BUFFER};
+        }
+    }
+    
+    void HandleSessionStateChange(XrSessionState state) {
+        std::cout << "[Frame " << m_samplerFrameCount.load() << "] Session state changed to: "
+                  << SessionStateName(state) << std::endl;
+        m_sessionState = state;
+        m_metrics.sessionState.Set(state);
+        switch (state) {
+            case XR_SESSION_STATE_READY:
+                m_readyTime = std::chrono::steady_clock::now();
+                BeginSession();
+                break;
+            case XR_SESSION_STATE_STOPPING:
+                EndSession();
+                break;
+            case XR_SESSION_STATE_LOSS_PENDING:
+                HandleSessionLoss("runtime reported LOSS_PENDING");
+                break;
+            case XR_SESSION_STATE_EXITING:
+                if (!m_exitRequested) {
+                    std::cout << "Runtime asked the session to exit" << std::endl;
+                    m_stopRequested.store(true);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    
+    // READY: begin the session and start sampling
+    void BeginSession() {
+        XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+        // Ignored for headless sessions, but the field must be valid
+        beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+        XrResult result = xrBeginSession(m_session, &beginInfo);
+        if (XR_FAILED(result)) {
+            std::cerr << "Failed to begin session: " << result << std::endl;
+            return;
+        }
+        m_sessionRunning = true;
+        if (m_handTrackingSupported) {
+            StartSampler();
+        }
+        std::cout << "Session running - sampling";
+        if (m_recoveryAttempts > 0) {
+            std::cout << " again " << std::fixed << std::setprecision(1)
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_lossTime).count()
+                      << " ms after the session was lost" << std::defaultfloat;
+            m_recoveryAttempts = 0;
+        }
+        std::cout << std::endl;
+    }
+    
+    // STOPPING: stop sampling before ending the session. Sampling only
+    // resumes if the runtime makes the session READY again, which it does
+    // not after our own exit request.
+    void EndSession() {
+        StopSampler();
+        if (m_sessionRunning) {
+            XrResult result = xrEndSession(m_session);
+            if (XR_FAILED(result)) {
+                std::cerr << "Failed to end session: " << result << std::endl;
+            }
+            m_sessionRunning = false;
+            if (!m_exitRequested) {
+                std::cout << "Session stopped - sampling paused" << std::endl;
+            }
+        }
+    }
+    
+    // The session is gone: tear it down and recreate it from the main loop
+    void HandleSessionLoss(const char* reason) {
+        m_sessionLost.store(false, std::memory_order_relaxed);
+        if (m_recovering || m_session == XR_NULL_HANDLE) {
+            return;
+        }
+        std::cout << "Session lost (" << reason << ") - recreating session and hand trackers" << std::endl;
+        StopSampler();
+        DestroySession();
+        m_lossTime = std::chrono::steady_clock::now();
+        m_recovering = true;
+        m_recoveryAttempts = 0;
+        m_recoveryDelay = FIRST_RECOVERY_DELAY;
+        m_nextRecoveryAttempt = m_lossTime;
+    }
+    
+    // Retries with exponential backoff; the new session then goes through
+    // IDLE -> READY like the first one
+    void TryRecoverSession() {
+        auto now = std::chrono::steady_clock::now();
+        if (now < m_nextRecoveryAttempt) {
+            return;
+        }
+        m_recoveryAttempts++;
+        if (CreateSimpleSession() && CreateHandTrackers()) {
+            m_recovering = false;
+            m_sessionRecoveries++;
+            m_metrics.sessionRecoveries.Add();
+            std::cout << "Session recreated (attempt " << m_recoveryAttempts << ", " << std::fixed << std::setprecision(1)
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_lossTime).count()
+                      << " ms after the loss)" << std::defaultfloat << std::endl;
+            return;
+        }
+        DestroySession();
+        m_nextRecoveryAttempt = now + m_recoveryDelay;
+        std::cout << "Session recreation failed - retrying in " << m_recoveryDelay.count() << " ms" << std::endl;
+        m_recoveryDelay = std::min(m_recoveryDelay * 2, MAX_RECOVERY_DELAY);
+    }
+    
+    // Asks a running session to stop and waits (bounded) for STOPPING so it
+    // can be ended cleanly
+    void ExitSession() {
+        if (!m_sessionRunning) {
+            return;
+        }
+        m_exitRequested = true;
+        if (XR_FAILED(xrRequestExitSession(m_session))) {
+            EndSession();
+            return;
+        }
+        auto deadline = std::chrono::steady_clock::now() + EXIT_SESSION_TIMEOUT;
+        while (m_sessionRunning && std::chrono::steady_clock::now() < deadline) {
+            PollEvents();
+            std::this_thread::sleep_for(EVENT_POLL_PERIOD);
+        }
+    }
+    
+    // Hand trackers, reference space and session; each only if it exists
+    void DestroySession() {
+        for (XrHandTrackerEXT& tracker : m_handTrackers) {
+            if (tracker != XR_NULL_HANDLE) {
+                m_xrDestroyHandTrackerEXT(tracker);
+                tracker = XR_NULL_HANDLE;
+            }
+        }
+        if (m_appSpace != XR_NULL_HANDLE) {
+            xrDestroySpace(m_appSpace);
+            m_appSpace = XR_NULL_HANDLE;
+        }
+        if (m_session != XR_NULL_HANDLE) {
+            xrDestroySession(m_session);
+            m_session = XR_NULL_HANDLE;
+        }
+        m_sessionRunning = false;
+        m_sessionState = XR_SESSION_STATE_UNKNOWN;
+        m_metrics.sessionState.Set(m_sessionState);
+    }
+    
+    void StartSampler() {
+        if (m_samplerThread.joinable()) {
+            return;
+        }
+        m_samplerRunning.store(true);
+        m_samplerThread = std::thread(&HandTrackingOnlyApp::SamplerLoop, this);
+    }
+    
+    void StopSampler() {
+        m_samplerRunning.store(false);
+        if (m_samplerThread.joinable()) {
+            m_samplerThread.join();
+        }
+    }
+    
+    // The buffers only the sampler writes per frame: the triple buffer's
+    // slots, the filter, gesture and velocity state, and the rings it
+    // pushes to. The metrics stay out; the main thread sets some of them.
+    void PrefaultSamplerBuffers() {
+        PrefaultPages(m_latestFrame.StorageData(), m_latestFrame.StorageBytes());
+        PrefaultPages(&m_jointFilter, sizeof(m_jointFilter));
+        PrefaultPages(&m_gestureEngine, sizeof(m_gestureEngine));
+        PrefaultPages(m_gestureEvents, sizeof(m_gestureEvents));
+        PrefaultPages(&m_velocityEstimator, sizeof(m_velocityEstimator));
+        PrefaultPages(m_estimatedVelocities, sizeof(m_estimatedVelocities));
+        for (FrameConsumerThread* consumer : m_consumers) {
+            PrefaultPages(consumer->Ring().StorageData(), consumer->Ring().StorageBytes());
+        }
+        if (m_eventSenderThread) {
+            PrefaultPages(m_eventSenderThread->Ring().StorageData(), m_eventSenderThread->Ring().StorageBytes());
+        }
+        PrefaultPages(m_samplerLog->StorageData(), m_samplerLog->StorageBytes());
+    }
+    
+    // Only while the sampler is stopped
+    void RemoveConsumer(FrameConsumerThread* consumer) {
+        m_consumers.erase(std::remove(m_consumers.begin(), m_consumers.end(), consumer), m_consumers.end());
+    }
+    
+    // Capture-to-delivery latency of each consumer over the last interval
+    void PrintDeliveryLatency() {
+        if (m_recorderThread && m_recorderThread->TakeDeliveryLatency(m_statusLatency)) {
+            m_statusLatency.Print(std::cout, "[Status] Latency recorder");
+        }
+        if (m_streamerThread && m_streamerThread->TakeDeliveryLatency(m_statusLatency)) {
+            m_statusLatency.Print(std::cout, "[Status] Latency stream");
+        }
+        if (m_eventSenderThread && m_eventSenderThread->TakeDeliveryLatency(m_statusLatency)) {
+            m_statusLatency.Print(std::cout, "[Status] Latency gesture events");
+        }
+    }
+    
+    // Main thread: what the scheduler measured over the last status interval
+    void RecordIntervalMetrics(const SamplingScheduler::Stats& stats) {
+        if (!m_metricsEnabled) {
+            return;
+        }
+        m_metrics.achievedRateHz.Set(stats.AchievedRate());
+        m_metrics.wakeJitterRmsUs.Set(stats.jitterRmsUs);
+        m_metrics.wakeJitterMaxUs.Set(stats.jitterMaxUs);
+        m_metrics.overruns.Add(stats.overruns);
+        m_metrics.skippedTicks.Add(stats.skippedTicks);
+    }
+    
+    // Metrics thread: renders every metric for one scrape. Everything it
+    // reads is either atomic or fixed before the endpoint starts.
+    void WriteMetrics(std::string& out) {
+        PrometheusWriter writer(out);
+        writer.Metric("handtracking_frames_total", "counter", "Frames sampled", m_metrics.frames.Get());
+        writer.Metric("handtracking_target_rate_hz", "gauge", "Configured sampling rate, 0 = free-running", m_config.sampleRateHz);
+        writer.Metric("handtracking_achieved_rate_hz", "gauge", "Sampling rate over the last status interval", m_metrics.achievedRateHz.Get());
+        writer.Metric("handtracking_wake_jitter_rms_us", "gauge", "RMS tick wake-up jitter over the last status interval", m_metrics.wakeJitterRmsUs.Get());
+        writer.Metric("handtracking_wake_jitter_max_us", "gauge", "Largest tick wake-up jitter over the last status interval", m_metrics.wakeJitterMaxUs.Get());
+        writer.Metric("handtracking_overruns_total", "counter", "Frames that took longer than the tick period", m_metrics.overruns.Get());
+        writer.Metric("handtracking_skipped_ticks_total", "counter", "Ticks skipped after an overrun", m_metrics.skippedTicks.Get());
+        writer.Histogram("handtracking_frame_seconds", "Sampler time per frame from wake-up to fan-out", m_metrics.frameTime);
+        writer.Histogram("handtracking_locate_call_seconds", "Duration of each xrLocateHandJointsEXT call", m_metrics.locateCall);
+        
+        writer.Header("handtracking_locate_failures_total", "counter", "Failed locate calls by hand and XrResult");
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            const ResultCounters& failures = m_metrics.hands[hand].failures;
+            for (int slot = 0; slot < failures.GetUsed(); ++slot) {
+                writer.Sample("handtracking_locate_failures_total",
+                              HandLabel(hand) + ",result=\"" + std::to_string(failures.GetResult(slot)) + "\"",
+                              failures.GetCount(slot));
+            }
+            if (failures.GetOtherCount() > 0) {
+                writer.Sample("handtracking_locate_failures_total", HandLabel(hand) + ",result=\"other\"",
+                              failures.GetOtherCount());
+            }
+        }
+        writer.Header("handtracking_hand_active_frames_total", "counter", "Frames in which the hand was tracked");
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            writer.Sample("handtracking_hand_active_frames_total", HandLabel(hand), m_metrics.hands[hand].activeFrames.Get());
+        }
+        writer.Header("handtracking_hand_active_ratio", "gauge", "Share of all frames in which the hand was tracked");
+        const double frames = static_cast<double>(m_metrics.frames.Get());
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            writer.Sample("handtracking_hand_active_ratio", HandLabel(hand),
+                          frames > 0.0 ? m_metrics.hands[hand].activeFrames.Get() / frames : 0.0);
+        }
+        writer.Header("handtracking_invalid_joints_total", "counter", "Joints of tracked hands without a valid position or orientation");
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            writer.Sample("handtracking_invalid_joints_total", HandLabel(hand) + ",component=\"position\"",
+                          m_metrics.hands[hand].positionInvalidJoints.Get());
+            writer.Sample("handtracking_invalid_joints_total", HandLabel(hand) + ",component=\"orientation\"",
+                          m_metrics.hands[hand].orientationInvalidJoints.Get());
+        }
+        
+        writer.Header("handtracking_ring_dropped_total", "counter", "Items dropped because a consumer fell behind");
+        if (m_recorderThread) {
+            writer.Sample("handtracking_ring_dropped_total", "ring=\"recorder\"", m_recorderThread->Ring().GetDroppedCount());
+        }
+        if (m_streamerThread) {
+            writer.Sample("handtracking_ring_dropped_total", "ring=\"stream\"", m_streamerThread->Ring().GetDroppedCount());
+        }
+        if (m_eventSenderThread) {
+            writer.Sample("handtracking_ring_dropped_total", "ring=\"gesture_events\"", m_eventSenderThread->Ring().GetDroppedCount());
+        }
+        writer.Sample("handtracking_ring_dropped_total", "ring=\"log\"", m_logger.GetDroppedCount());
+        writer.Metric("handtracking_log_records_total", "counter", "Tracking log records written", m_logger.GetWrittenCount());
+        if (m_config.gestures) {
+            writer.Metric("handtracking_gesture_events_total", "counter", "Gesture events detected", m_metrics.gestureEvents.Get());
+        }
+        
+        writer.Header("handtracking_startup_phase_seconds", "gauge", "Duration of each startup phase");
+        for (const StartupTimer::Phase& phase : m_startup.GetPhases()) {
+            writer.Sample("handtracking_startup_phase_seconds", std::string("phase=\"") + phase.name + "\"",
+                          (phase.endNs - phase.beginNs) / 1e9);
+        }
+        if (m_startup.HasFirstValidFrame()) {
+            writer.Metric("handtracking_first_valid_frame_seconds", "gauge", "Time from start to the first frame with a tracked hand",
+                          m_startup.FirstValidFrameMs() / 1e3);
+        }
+        if (!m_standIn) {
+            writer.Metric("handtracking_session_state", "gauge", "Current XrSessionState, 0 without a session", m_metrics.sessionState.Get());
+            writer.Metric("handtracking_session_recoveries_total", "counter", "Sessions recreated after a loss", m_metrics.sessionRecoveries.Get());
+        }
+    }
+    
+    // Every Start() after the first records to a new file (session-2.htrec,
+    // session-3.htrec, ...) so a restart never truncates an earlier run
+    bool StartRecorder() {
+        m_recordRuns++;
+        const std::string path = RecordingPathForRun(m_config.recordPath, m_recordRuns);
+        if (!m_recorder.Open(path, m_config.sampleRateHz)) {
+            return false;
+        }
+        m_recorderThread = std::make_unique<FrameConsumerThread>(m_config.frameRingCapacity, m_config.overflowPolicy);
+        m_recorderThread->Start([this](const HandFrame& frame) { m_recorder.Append(frame); });
+        m_consumers.push_back(m_recorderThread.get());
+        std::cout << "Recording every frame to " << path << std::endl;
+        return true;
+    }
+    
+    // Must run after StopSampler() so the final drain sees every frame
+    void StopRecorder() {
+        if (!m_recorderThread) {
+            return;
+        }
+        m_recorderThread->Stop();
+        m_recorder.Close();
+        std::cout << "Recording closed: " << m_recorder.GetFramesWritten() << " frames written to "
+                  << m_recorder.GetPath() << std::endl;
+        RemoveConsumer(m_recorderThread.get());
+        m_recorderThread.reset();
+    }
+    
+    bool StartStreamer() {
+        if (!m_streamer.Open(m_config.streamDestination, m_config.streamKeyframeInterval)) {
+            return false;
+        }
+        m_streamerThread = std::make_unique<FrameConsumerThread>(m_config.frameRingCapacity, m_config.overflowPolicy);
+        m_streamerThread->Start([this](const HandFrame& frame) { m_streamer.Send(frame); });
+        m_consumers.push_back(m_streamerThread.get());
+        std::cout << "Streaming frames to " << m_config.streamDestination << " (keyframe every "
+                  << m_config.streamKeyframeInterval << " frames)" << std::endl;
+        return true;
+    }
+    
+    // Must run after StopSampler(), like StopRecorder()
+    void StopStreamer() {
+        if (!m_streamerThread) {
+            return;
+        }
+        m_streamerThread->Stop();
+        m_streamer.Close();
+        std::cout << "Stream closed: " << m_streamer.GetPacketsSent() << " packets, "
+                  << m_streamer.GetBytesSent() << " bytes sent to " << m_streamer.GetDestination() << std::endl;
+        RemoveConsumer(m_streamerThread.get());
+        m_streamerThread.reset();
+    }
+    
+    // Events are rare, so the ring never drops in practice; the sampler
+    // pushes to it directly instead of through m_consumers
+    bool StartEventSender() {
+        if (!m_eventSender.Open(m_config.gestureDestination)) {
+            return false;
+        }
+        m_eventSenderThread = std::make_unique<ConsumerThread<GestureEvent>>(EVENT_RING_CAPACITY, m_config.overflowPolicy);
+        m_eventSenderThread->Start([this](const GestureEvent& event) { m_eventSender.Send(event); });
+        std::cout << "Sending gesture events to " << m_config.gestureDestination << std::endl;
+        return true;
+    }
+    
+    // Must run after StopSampler(), like StopRecorder()
+    void StopEventSender() {
+        if (!m_eventSenderThread) {
+            return;
+        }
+        m_eventSenderThread->Stop();
+        m_eventSender.Close();
+        std::cout << "Gesture events closed: " << m_eventSender.GetEventsSent() << " events sent to "
+                  << m_eventSender.GetDestination() << std::endl;
+        m_eventSenderThread.reset();
+    }
+    
+    // Sampler thread: locates joints, hands frames to the rings, publishes
+    // them to shared memory and queues binary log records. Everything that
+    // can block (formatting, I/O) happens in the consumers and the logger
+    // thread.
+    void SamplerLoop() {
+        SamplingScheduler scheduler(m_config.sampleRateHz, std::chrono::microseconds(m_config.spinTailUs));
+        auto lastStatsTime = std::chrono::steady_clock::now();
+        // Continues across restarts (the sampler only runs while the session does)
+        uint64_t frameIndex = m_samplerFrameCount.load();
+        
+        // From here on the loop neither allocates nor uses iostreams, so
+        // with real-time mode nothing in it waits on a page fault or a lock
+        if (m_config.realtime.enabled) {
+            PrefaultSamplerBuffers();
+            m_realtimeStatus = ApplyRealtimeToCurrentThread(m_config.realtime);
+            m_realtimeStatusReady.store(true, std::memory_order_release);
+        }
+        
+        while (m_samplerRunning.load(std::memory_order_relaxed)) {
+            scheduler.WaitForNextTick();
+            const int64_t frameStartNs = m_metricsEnabled ? XrTimeSource::NowNs() : 0;
+            
+            HandFrame& frame = m_latestFrame.WriteBuffer();
+            frame.frameIndex = frameIndex++;
+            LocateHands(frame);
+            if (frame.hands[0].result == XR_ERROR_SESSION_LOST || frame.hands[1].result == XR_ERROR_SESSION_LOST) {
+                m_sessionLost.store(true, std::memory_order_relaxed);
+            }
+            if (!m_startup.HasFirstValidFrame()) {
+                for (const HandFrame::Hand& hand : frame.hands) {
+                    if (XR_SUCCEEDED(hand.result) && hand.isActive) {
+                        m_startup.MarkFirstValidFrame(frame.sampleTimeNs);
+                    }
+                }
+            }
+            // The recorder keeps the raw poses so replays can be filtered
+            // with other settings
+            if (m_recorderThread) {
+                m_recorderThread->Push(frame);
+            }
+            FilterFrame(frame);
+            // Events go out before the frame fan-out so that event
+            // subscribers see a change as early as possible
+            DetectGestures(frame);
+            for (FrameConsumerThread* consumer : m_consumers) {
+                if (consumer != m_recorderThread.get()) {
+                    consumer->Push(frame);
+                }
+            }
+            if (m_shmPublisher.IsOpen()) {
+                m_shmPublisher.Publish(frame);
+            }
+            if (m_frameCallback != nullptr) {
+                m_frameCallback(frame, m_frameCallbackUserData);
+            }
+            LogFrame(frame);
+            if (m_metricsEnabled) {
+                RecordFrameMetrics(frame, frameStartNs);
+            }
+            // The frame is not touched after this; the next one is built
+            // in another slot
+            m_latestFrame.Publish();
+            m_samplerFrameCount.store(frameIndex, std::memory_order_relaxed);
+            
+            // Hand the interval statistics over once the previous ones were printed
+            auto currentTime = std::chrono::steady_clock::now();
+            if (currentTime - lastStatsTime >= STATUS_LOG_PERIOD &&
+                !m_samplerStatsReady.load(std::memory_order_acquire)) {
+                m_samplerStats = scheduler.TakeIntervalStats();
+                m_filterStats = m_jointFilter.TakeStats();
+                m_samplerStatsReady.store(true, std::memory_order_release);
+                lastStatsTime = currentTime;
+            }
+        }
+    }
+    
+public:
+    // Locates both hands into frame. Public so the benchmark can drive the
+    // per-frame path without the sampler thread; when locateLatency is set,
+    // the duration of every locate call is recorded into it.
+    void LocateHands(HandFrame& frame, LatencyHistogram* locateLatency = nullptr) {
+        // Both hands are located for the same XrTime: the sample time plus
+        // the prediction offset
+        frame.sampleTimeNs = XrTimeSource::NowNs();
+        frame.locateTime = m_timeSource.ToXrTime(frame.sampleTimeNs + m_config.predictionOffsetNs);
+        
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            HandFrame::Hand& handData = frame.hands[hand];
+            if (m_handTrackers[hand] == XR_NULL_HANDLE) {
+                handData.result = XR_ERROR_HANDLE_INVALID;
+                handData.isActive = XR_FALSE;
+                handData.jointCount = 0;
+                handData.velocitySource = VelocitySource::None;
+                continue;
+            }
+            
+            // Ask for velocities in the same call; runtimes that do not
+            // support them leave every velocityFlags at 0
+            XrHandJointVelocitiesEXT velocities{XR_TYPE_HAND_JOINT_VELOCITIES_EXT};
+            velocities.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            velocities.jointVelocities = handData.velocities;
+            for (XrHandJointVelocityEXT& velocity : handData.velocities) {
+                velocity.velocityFlags = 0;
+            }
+            
+            XrHandJointLocationsEXT locations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
+            locations.next = &velocities;
+            locations.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            locations.jointLocations = handData.joints;
+
+            XrHandJointsLocateInfoEXT locateInfo{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+            locateInfo.baseSpace = m_appSpace;
+            locateInfo.time = frame.locateTime;
+
+            if (locateLatency != nullptr || m_metricsEnabled) {
+                auto callStart = std::chrono::steady_clock::now();
+                handData.result = m_xrLocateHandJointsEXT(m_handTrackers[hand], &locateInfo, &locations);
+                uint64_t callNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - callStart).count();
+                if (locateLatency != nullptr) {
+                    locateLatency->Record(callNs);
+                }
+                if (m_metricsEnabled) {
+                    m_metrics.locateCall.Observe(callNs);
+                }
+            } else {
+                handData.result = m_xrLocateHandJointsEXT(m_handTrackers[hand], &locateInfo, &locations);
+            }
+            handData.isActive = XR_SUCCEEDED(handData.result) ? locations.isActive : XR_FALSE;
+            handData.jointCount = locations.jointCount;
+            FillVelocities(hand, handData, frame.locateTime);
+        }
+    }
+    
+    // Smooths the joint poses of a located frame in place (no-op when the
+    // filter is off)
+    void FilterFrame(HandFrame& frame) {
+        if (!m_jointFilter.IsEnabled()) {
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        m_jointFilter.Apply(frame);
+        m_jointFilter.RecordDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    
+    // Runs the gesture engine on a (filtered) frame, hands any events to
+    // the event sender and queues them for the log. Returns the event count;
+    // 0 when gesture detection is off.
+    int DetectGestures(const HandFrame& frame) {
+        if (!m_config.gestures) {
+            return 0;
+        }
+        int count = m_gestureEngine.Update(frame, m_gestureEvents);
+        if (count > 0 && m_metricsEnabled) {
+            m_metrics.gestureEvents.Add(count);
+        }
+        for (int i = 0; i < count; ++i) {
+            const GestureEvent& event = m_gestureEvents[i];
+            if (m_eventSenderThread) {
+                m_eventSenderThread->Push(event);
+            }
+            if (m_logger.IsEnabled(LogLevel::Events)) {
+                LogRecord record = MakeLogRecord(LogEvent::Gesture, event.frameIndex, event.hand);
+                record.joint = static_cast<uint8_t>(event.type);
+                record.intArg = event.sampleTimeNs - event.onsetTimeNs;
+                record.values[0] = event.value;
+                record.values[1] = event.position.x;
+                record.values[2] = event.position.y;
+                record.values[3] = event.position.z;
+                m_samplerLog->Push(record);
+            }
+        }
+        return count;
+    }
+    
+    // Counts a finished frame into the metrics; frameStartNs is when its
+    // tick woke the sampler
+    void RecordFrameMetrics(const HandFrame& frame, int64_t frameStartNs) {
+        m_metrics.RecordFrame(frame);
+        m_metrics.frameTime.Observe(static_cast<uint64_t>(XrTimeSource::NowNs() - frameStartNs));
+    }
+    
+    // Keeps runtime velocities if there are any, otherwise estimates them
+    // from the previous sample. The estimator always sees the new sample
+    // so it is ready if the runtime stops providing velocities.
+    void FillVelocities(int hand, HandFrame::Hand& handData, XrTime locateTime) {
+        bool runtimeVelocities = false;
+        if (XR_SUCCEEDED(handData.result) && handData.isActive) {
+            for (const XrHandJointVelocityEXT& velocity : handData.velocities) {
+                if (velocity.velocityFlags & (XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT)) {
+                    runtimeVelocities = true;
+                    break;
+                }
+            }
+        }
+        
+        if (runtimeVelocities) {
+            m_velocityEstimator.Estimate(hand, handData, locateTime, m_estimatedVelocities);
+            handData.velocitySource = VelocitySource::Runtime;
+            return;
+        }
+        m_velocityEstimator.Estimate(hand, handData, locateTime, handData.velocities);
+        bool estimated = false;
+        for (const XrHandJointVelocityEXT& velocity : handData.velocities) {
+            estimated = estimated || velocity.velocityFlags != 0;
+        }
+        handData.velocitySource = estimated ? VelocitySource::Estimated : VelocitySource::None;
+    }
+    
+    // Queues activity transitions, failures and periodic joint dumps as
+    // binary records for the logger thread. Allocation- and I/O-free.
+    void LogFrame(const HandFrame& frame) {
+        // Joint dumps are paced by sample time so the log stays readable
+        // regardless of the sampling rate
+        bool logDetail = m_logger.IsEnabled(LogLevel::Joints) && frame.sampleTimeNs >= m_nextDetailLogNs;
+        bool logPalm = !logDetail && m_logger.IsEnabled(LogLevel::Palm) && frame.sampleTimeNs >= m_nextPalmLogNs;
+        if (logDetail) {
+            m_nextDetailLogNs = frame.sampleTimeNs + std::chrono::nanoseconds(DETAIL_LOG_PERIOD).count();
+            m_nextPalmLogNs = frame.sampleTimeNs + std::chrono::nanoseconds(PALM_LOG_PERIOD).count();
+        } else if (logPalm) {
+            m_nextPalmLogNs = frame.sampleTimeNs + std::chrono::nanoseconds(PALM_LOG_PERIOD).count();
+        }
+        
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            if (m_handTrackers[hand] == XR_NULL_HANDLE) continue;
+            
+            const HandFrame::Hand& handData = frame.hands[hand];
+            
+            if (XR_FAILED(handData.result)) {
+                LogRecord record = MakeLogRecord(LogEvent::LocateFailed, frame.frameIndex, hand);
+                record.intArg = handData.result;
+                m_samplerLog->Push(record);
+                m_lastHandActive[hand] = false;
+                continue;
+            }
+            
+            if (!handData.isActive) {
+                // Log when hand becomes inactive
+                if (m_lastHandActive[hand] && m_logger.IsEnabled(LogLevel::Events)) {
+                    m_samplerLog->Push(MakeLogRecord(LogEvent::HandInactive, frame.frameIndex, hand));
+                }
+                m_lastHandActive[hand] = false;
+                continue;
+            }
+            
+            // Log when hand becomes active
+            if (!m_lastHandActive[hand] && m_logger.IsEnabled(LogLevel::Events)) {
+                m_samplerLog->Push(MakeLogRecord(LogEvent::HandActive, frame.frameIndex, hand));
+            }
+            m_lastHandActive[hand] = true;
+            
+            // Log key joints every ~2 seconds
+            if (logDetail) {
+                static const XrHandJointEXT keyJoints[] = {
+                    XR_HAND_JOINT_WRIST_EXT,
+                    XR_HAND_JOINT_PALM_EXT,
+                    XR_HAND_JOINT_THUMB_TIP_EXT,
+                    XR_HAND_JOINT_INDEX_TIP_EXT,
+                    XR_HAND_JOINT_MIDDLE_TIP_EXT,
+                    XR_HAND_JOINT_RING_TIP_EXT,
+                    XR_HAND_JOINT_LITTLE_TIP_EXT
+                };
+                
+                LogRecord record = MakeLogRecord(LogEvent::JointDumpBegin, frame.frameIndex, hand);
+                record.intArg = handData.jointCount;
+                m_samplerLog->Push(record);
+                
+                for (XrHandJointEXT joint : keyJoints) {
+                    if (static_cast<uint32_t>(joint) >= handData.jointCount) continue;
+                    
+                    const XrHandJointLocationEXT& location = handData.joints[joint];
+                    record = MakeLogRecord(LogEvent::JointDump, frame.frameIndex, hand);
+                    record.joint = static_cast<uint8_t>(joint);
+                    record.intArg = static_cast<int64_t>(location.locationFlags);
+                    record.values[0] = location.pose.position.x;
+                    record.values[1] = location.pose.position.y;
+                    record.values[2] = location.pose.position.z;
+                    record.values[3] = location.pose.orientation.x;
+                    record.values[4] = location.pose.orientation.y;
+                    record.values[5] = location.pose.orientation.z;
+                    record.values[6] = location.pose.orientation.w;
+                    record.values[7] = location.radius;
+                    m_samplerLog->Push(record);
+                }
+                m_samplerLog->Push(MakeLogRecord(LogEvent::JointDumpEnd, frame.frameIndex, hand));
+            }
+            
+            // Quick status every ~0.5 seconds
+            else if (logPalm && handData.jointCount > XR_HAND_JOINT_PALM_EXT) {
+                const XrHandJointLocationEXT& palm = handData.joints[XR_HAND_JOINT_PALM_EXT];
+                if (palm.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) {
+                    LogRecord record = MakeLogRecord(LogEvent::PalmPosition, frame.frameIndex, hand);
+                    record.values[0] = palm.pose.position.x;
+                    record.values[1] = palm.pose.position.y;
+                    record.values[2] = palm.pose.position.z;
+                    const XrHandJointVelocityEXT& velocity = handData.velocities[XR_HAND_JOINT_PALM_EXT];
+                    if (velocity.velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
+                        record.intArg = static_cast<int64_t>(handData.velocitySource);
+                        record.values[3] = velocity.linearVelocity.x;
+                        record.values[4] = velocity.linearVelocity.y;
+                        record.values[5] = velocity.linearVelocity.z;
+                    }
+                    m_samplerLog->Push(record);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,461 @@
+#pragma once
+
+#include "hand_frame.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+// ============================================================================
+// Per-joint pose filtering with short-horizon prediction
+// ============================================================================
+// Smooths the joint poses of every frame once, on the sampler thread, so
+// consumers no longer each run their own smoothing (each with its own lag).
+// Two filters are available, both applied independently to each position
+// and quaternion component of every joint:
+//
+//   One Euro   A low-pass filter whose cutoff rises with speed: strong
+//              smoothing at rest, little lag during fast motion. Its lag
+//              for steady motion is the filter time constant, so the output
+//              is extrapolated by that much (lagCompensation) to cancel it.
+//   Kalman     A constant-velocity Kalman filter. It tracks steady motion
+//              without lag and also estimates the velocity.
+//
+// Both can extrapolate a further predictionMs along the estimated velocity.
+// Parameters are set per joint group (palm and wrist, then each finger).
+// Quaternion components are scaled by ORIENTATION_SCALE before filtering,
+// which makes them roughly arc lengths in meters. The same parameters then
+// suit positions and orientations. Filtered quaternions are renormalized.
+//
+// State is kept as structure-of-arrays padded to 32 lanes, like
+// JointVelocityEstimator, so each pass is a straight loop the compiler
+// vectorizes. Apply() never allocates.
+// ============================================================================
+
+enum class FilterMode : uint32_t {
+    Off = 0,
+    OneEuro = 1,
+    Kalman = 2,
+};
+
+inline const char* FilterModeName(FilterMode mode) {
+    switch (mode) {
+        case FilterMode::Off: return "off";
+        case FilterMode::OneEuro: return "one-euro";
+        case FilterMode::Kalman: return "kalman";
+    }
+    return "unknown";
+}
+
+inline bool ParseFilterMode(const std::string& name, FilterMode& mode) {
+    for (FilterMode candidate : {FilterMode::Off, FilterMode::OneEuro, FilterMode::Kalman}) {
+        if (name == FilterModeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Joints sharing one set of filter parameters
+constexpr int JOINT_GROUP_COUNT = 6;
+
+inline int JointGroupOf(int joint) {
+    // Palm and wrist, then 4 thumb joints and 5 for each other finger
+    if (joint <= XR_HAND_JOINT_WRIST_EXT) return 0;
+    if (joint <= XR_HAND_JOINT_THUMB_TIP_EXT) return 1;
+    return 2 + (joint - XR_HAND_JOINT_INDEX_METACARPAL_EXT) / 5;
+}
+
+inline const char* JointGroupName(int group) {
+    static const char* const names[JOINT_GROUP_COUNT] = {"palm", "thumb", "index", "middle", "ring", "little"};
+    return group >= 0 && group < JOINT_GROUP_COUNT ? names[group] : "unknown";
+}
+
+struct JointFilterParams {
+    // One Euro
+    float minCutoffHz = 1.0f;         // cutoff at rest
+    float beta = 20.0f;               // cutoff increase in Hz per m/s of speed
+    float derivativeCutoffHz = 5.0f;  // cutoff of the speed estimate
+    float lagCompensation = 1.0f;     // share of the filter lag to extrapolate away (0-1)
+
+    // Kalman
+    float measurementNoise = 0.0005f;  // measurement standard deviation, meters
+    float processNoise = 10.0f;        // acceleration standard deviation, m/s^2
+
+    // Both
+    float predictionMs = 0.0f;  // extra extrapolation along the estimated velocity
+};
+
+// Applies "<group|all>.<name>=<value>" (e.g. "index.beta=40") to params
+inline bool ParseFilterParam(const std::string& spec, JointFilterParams (&params)[JOINT_GROUP_COUNT]) {
+    size_t dot = spec.find('.');
+    size_t equals = spec.find('=', dot == std::string::npos ? 0 : dot);
+    if (dot == std::string::npos || equals == std::string::npos) {
+        return false;
+    }
+    std::string group = spec.substr(0, dot);
+    std::string name = spec.substr(dot + 1, equals - dot - 1);
+    std::string text = spec.substr(equals + 1);
+    char* end = nullptr;
+    float value = std::strtof(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !std::isfinite(value) || value < 0.0f) {
+        return false;
+    }
+
+    bool matched = false;
+    for (int g = 0; g < JOINT_GROUP_COUNT; ++g) {
+        if (group != "all" && group != JointGroupName(g)) {
+            continue;
+        }
+        JointFilterParams& p = params[g];
+        float* field = name == "min-cutoff" ? &p.minCutoffHz
+                     : name == "beta" ? &p.beta
+                     : name == "d-cutoff" ? &p.derivativeCutoffHz
+                     : name == "lag-compensation" ? &p.lagCompensation
+                     : name == "measurement-noise" ? &p.measurementNoise
+                     : name == "process-noise" ? &p.processNoise
+                     : name == "prediction-ms" ? &p.predictionMs
+                     : nullptr;
+        if (field == nullptr) {
+            return false;
+        }
+        *field = value;
+        matched = true;
+    }
+    return matched;
+}
+
+class JointFilter {
+public:
+    // Jitter is the RMS second difference of joint positions between
+    // consecutive frames, before and after filtering
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t totalNs = 0;  // filter time, summed over frames
+        uint64_t maxNs = 0;
+        double rawJitterSquared = 0.0;
+        double filteredJitterSquared = 0.0;
+        uint64_t jitterSamples = 0;
+
+        double MeanNs() const { return frames ? static_cast<double>(totalNs) / frames : 0.0; }
+        double RawJitterM() const { return jitterSamples ? std::sqrt(rawJitterSquared / jitterSamples) : 0.0; }
+        double FilteredJitterM() const { return jitterSamples ? std::sqrt(filteredJitterSquared / jitterSamples) : 0.0; }
+    };
+
+    void Configure(FilterMode mode, const JointFilterParams (&params)[JOINT_GROUP_COUNT]) {
+        m_mode = mode;
+        for (int j = 0; j < LANES; ++j) {
+            // Padding lanes copy the palm parameters and are never valid
+            const JointFilterParams& p = params[j < N ? JointGroupOf(j) : 0];
+            m_minCutoffHz[j] = p.minCutoffHz;
+            m_beta[j] = p.beta;
+            m_derivativeAlphaTau[j] = 1.0f / (TWO_PI * std::max(p.derivativeCutoffHz, 1e-3f));
+            m_lagCompensation[j] = p.lagCompensation;
+            m_measurementVariance[j] = std::max(p.measurementNoise * p.measurementNoise, 1e-12f);
+            m_accelerationVariance[j] = p.processNoise * p.processNoise;
+            m_predictionS[j] = p.predictionMs * 1e-3f;
+        }
+        Reset();
+    }
+
+    bool IsEnabled() const { return m_mode != FilterMode::Off; }
+    FilterMode GetMode() const { return m_mode; }
+
+    void Reset() {
+        for (HandState& state : m_state) {
+            state.valid = false;
+        }
+    }
+
+    // Filters the joint poses of frame in place. Joints that are not fully
+    // valid are left untouched and restart their filter when they return.
+    void Apply(HandFrame& frame) {
+        if (m_mode == FilterMode::Off) {
+            return;
+        }
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            ApplyHand(frame.hands[hand], frame.sampleTimeNs, m_state[hand]);
+        }
+        m_stats.frames++;
+    }
+
+    // Time spent in Apply(), measured by the caller
+    void RecordDuration(uint64_t ns) {
+        m_stats.totalNs += ns;
+        m_stats.maxNs = std::max(m_stats.maxNs, ns);
+    }
+
+    // Statistics since the previous call
+    Stats TakeStats() {
+        Stats stats = m_stats;
+        m_stats = Stats{};
+        return stats;
+    }
+
+private:
+    static constexpr int N = XR_HAND_JOINT_COUNT_EXT;
+    static constexpr int LANES = 32;
+    static constexpr int CHANNELS = 7;  // px, py, pz, qx, qy, qz, qw
+    static constexpr float TWO_PI = 6.28318531f;
+    // Meters per quaternion unit (q is about half the angle, so this is the
+    // arc length at a 5 cm lever arm)
+    static constexpr float ORIENTATION_SCALE = 0.1f;
+    // Longer gaps (dropouts, hands leaving) restart the filter
+    static constexpr int64_t MAX_INTERVAL_NS = 250000000;
+
+    struct HandState {
+        bool valid = false;
+        int64_t timeNs = 0;
+        alignas(32) float value[CHANNELS][LANES] = {};  // One Euro: filtered value, Kalman: position state
+        alignas(32) float rate[CHANNELS][LANES] = {};   // One Euro: filtered derivative, Kalman: velocity state
+        alignas(32) float trend[CHANNELS][LANES] = {};  // One Euro: smoothed velocity of the output, for extrapolation
+        alignas(32) float p00[LANES] = {};  // Kalman covariance, shared by the channels of a joint
+        alignas(32) float p01[LANES] = {};
+        alignas(32) float p11[LANES] = {};
+        alignas(32) float laneValid[LANES] = {};
+        // Last two raw and filtered positions, for the jitter statistics
+        alignas(32) float raw1[3][LANES] = {}, raw2[3][LANES] = {};
+        alignas(32) float out1[3][LANES] = {}, out2[3][LANES] = {};
+        alignas(32) float streak[LANES] = {};  // consecutive valid frames, up to 3
+    };
+
+    void ApplyHand(HandFrame::Hand& data, int64_t timeNs, HandState& state) {
+        if (XR_FAILED(data.result) || !data.isActive) {
+            state.valid = false;
+            return;
+        }
+        const int64_t dtNs = timeNs - state.timeNs;
+        const bool usable = state.valid && dtNs > 0 && dtNs <= MAX_INTERVAL_NS;
+        const float dt = usable ? static_cast<float>(dtNs) * 1e-9f : 0.0f;
+        const float keep = usable ? 1.0f : 0.0f;
+
+        // Transpose; quaternions are flipped into the hemisphere of the
+        // previous estimate so the components move continuously
+        alignas(32) float x[CHANNELS][LANES] = {};
+        alignas(32) float valid[LANES] = {};
+        alignas(32) float sign[LANES];
+        const XrSpaceLocationFlags bothValid = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+        for (int j = 0; j < N; ++j) {
+            const XrHandJointLocationEXT& joint = data.joints[j];
+            x[0][j] = joint.pose.position.x;
+            x[1][j] = joint.pose.position.y;
+            x[2][j] = joint.pose.position.z;
+            x[3][j] = joint.pose.orientation.x * ORIENTATION_SCALE;
+            x[4][j] = joint.pose.orientation.y * ORIENTATION_SCALE;
+            x[5][j] = joint.pose.orientation.z * ORIENTATION_SCALE;
+            x[6][j] = joint.pose.orientation.w * ORIENTATION_SCALE;
+            valid[j] = (joint.locationFlags & bothValid) == bothValid ? 1.0f : 0.0f;
+        }
+        for (int j = 0; j < LANES; ++j) {
+            const float dot = x[3][j] * state.value[3][j] + x[4][j] * state.value[4][j] +
+                              x[5][j] * state.value[5][j] + x[6][j] * state.value[6][j];
+            sign[j] = dot < 0.0f ? -1.0f : 1.0f;
+        }
+        for (int c = 3; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                x[c][j] *= sign[j];
+            }
+        }
+
+        // Lanes that start over take the measurement as their estimate
+        alignas(32) float update[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            update[j] = valid[j] * state.laneValid[j] * keep;
+        }
+
+        alignas(32) float out[CHANNELS][LANES];
+        if (m_mode == FilterMode::OneEuro) {
+            OneEuro(state, x, update, dt, out);
+        } else {
+            Kalman(state, x, update, dt, out);
+        }
+
+        // Jitter statistics over position channels
+        for (int j = 0; j < LANES; ++j) {
+            state.streak[j] = std::min(state.streak[j] + 1.0f, 3.0f) * valid[j];
+        }
+        double rawSquared = 0.0;
+        double filteredSquared = 0.0;
+        int samples = 0;
+        for (int j = 0; j < N; ++j) {
+            if (state.streak[j] >= 3.0f) {
+                for (int c = 0; c < 3; ++c) {
+                    const float raw = x[c][j] - 2.0f * state.raw1[c][j] + state.raw2[c][j];
+                    const float filtered = out[c][j] - 2.0f * state.out1[c][j] + state.out2[c][j];
+                    rawSquared += raw * raw;
+                    filteredSquared += filtered * filtered;
+                }
+                samples++;
+            }
+        }
+        m_stats.rawJitterSquared += rawSquared;
+        m_stats.filteredJitterSquared += filteredSquared;
+        m_stats.jitterSamples += samples;
+        for (int c = 0; c < 3; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                state.raw2[c][j] = state.raw1[c][j];
+                state.raw1[c][j] = x[c][j];
+                state.out2[c][j] = state.out1[c][j];
+                state.out1[c][j] = out[c][j];
+            }
+        }
+
+        // Write back valid joints with normalized orientations
+        for (int j = 0; j < N; ++j) {
+            if (valid[j] == 0.0f) {
+                continue;
+            }
+            XrPosef& pose = data.joints[j].pose;
+            pose.position = {out[0][j], out[1][j], out[2][j]};
+            const float length2 = out[3][j] * out[3][j] + out[4][j] * out[4][j] + out[5][j] * out[5][j] + out[6][j] * out[6][j];
+            if (length2 > 1e-12f) {
+                const float inv = sign[j] / std::sqrt(length2);
+                pose.orientation = {out[3][j] * inv, out[4][j] * inv, out[5][j] * inv, out[6][j] * inv};
+            }
+        }
+
+        for (int j = 0; j < LANES; ++j) {
+            state.laneValid[j] = valid[j];
+        }
+        state.timeNs = timeNs;
+        state.valid = true;
+    }
+
+    void OneEuro(HandState& state, const float (&x)[CHANNELS][LANES], const float (&update)[LANES], float dt,
+                 float (&out)[CHANNELS][LANES]) {
+        // Smoothed derivative of every channel
+        alignas(32) float alphaD[LANES];
+        const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+        for (int j = 0; j < LANES; ++j) {
+            alphaD[j] = dt / (dt + m_derivativeAlphaTau[j]);
+        }
+        alignas(32) float dx[CHANNELS][LANES];
+        for (int c = 0; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                const float raw = (x[c][j] - state.value[c][j]) * invDt;
+                dx[c][j] = (state.rate[c][j] + alphaD[j] * (raw - state.rate[c][j])) * update[j];
+            }
+        }
+
+        // Cutoff from speed: position speed for positions, arc speed for
+        // orientations
+        alignas(32) float tauPosition[LANES], tauOrientation[LANES];
+        alignas(32) float leadPosition[LANES], leadOrientation[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            const float speedPosition = std::sqrt(dx[0][j] * dx[0][j] + dx[1][j] * dx[1][j] + dx[2][j] * dx[2][j]);
+            const float speedOrientation = std::sqrt(dx[3][j] * dx[3][j] + dx[4][j] * dx[4][j] +
+                                                     dx[5][j] * dx[5][j] + dx[6][j] * dx[6][j]);
+            tauPosition[j] = 1.0f / (TWO_PI * (m_minCutoffHz[j] + m_beta[j] * speedPosition));
+            tauOrientation[j] = 1.0f / (TWO_PI * (m_minCutoffHz[j] + m_beta[j] * speedOrientation));
+            leadPosition[j] = m_lagCompensation[j] * tauPosition[j] + m_predictionS[j];
+            leadOrientation[j] = m_lagCompensation[j] * tauOrientation[j] + m_predictionS[j];
+        }
+
+        alignas(32) float value[CHANNELS][LANES], trend[CHANNELS][LANES];
+        for (int c = 0; c < CHANNELS; ++c) {
+            const float* tau = c < 3 ? tauPosition : tauOrientation;
+            for (int j = 0; j < LANES; ++j) {
+                const float alpha = update[j] * dt / (dt + tau[j]) + (1.0f - update[j]);
+                value[c][j] = state.value[c][j] + alpha * (x[c][j] - state.value[c][j]);
+                const float raw = (value[c][j] - state.value[c][j]) * invDt;
+                trend[c][j] = (state.trend[c][j] + alphaD[j] * (raw - state.trend[c][j])) * update[j];
+            }
+        }
+
+        // Output extrapolated by the filter lag. Results go through local
+        // arrays so no loop both reads and writes through a reference,
+        // which keeps every loop vectorizable without alias checks.
+        for (int c = 0; c < CHANNELS; ++c) {
+            const float* lead = c < 3 ? leadPosition : leadOrientation;
+            for (int j = 0; j < LANES; ++j) {
+                out[c][j] = value[c][j] + trend[c][j] * lead[j];
+            }
+        }
+        for (int c = 0; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                state.value[c][j] = value[c][j];
+                state.rate[c][j] = dx[c][j];
+                state.trend[c][j] = trend[c][j];
+            }
+        }
+    }
+
+    void Kalman(HandState& state, const float (&x)[CHANNELS][LANES], const float (&update)[LANES], float dt,
+                float (&out)[CHANNELS][LANES]) {
+        // Discrete white-noise acceleration model. The covariance does not
+        // depend on the measurements, so all channels of a joint share it
+        // and the gains are computed once per joint.
+        const float dt2 = dt * dt;
+        const float q00 = dt2 * dt2 * 0.25f;
+        const float q01 = dt2 * dt * 0.5f;
+        const float q11 = dt2;
+        alignas(32) float k0[LANES], k1[LANES];
+        alignas(32) float p00[LANES], p01[LANES], p11[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            const float r = m_measurementVariance[j];
+            const float qa = m_accelerationVariance[j];
+            const float u = update[j];
+            const float a00 = state.p00[j] + dt * (2.0f * state.p01[j] + dt * state.p11[j]) + qa * q00;
+            const float a01 = state.p01[j] + dt * state.p11[j] + qa * q01;
+            const float a11 = state.p11[j] + qa * q11;
+            const float s = a00 + r;
+            k0[j] = a00 / s;
+            k1[j] = a01 / s;
+            // Restarting lanes: measurement variance, wide velocity prior
+            p00[j] = u * (a00 - k0[j] * a00) + (1.0f - u) * r;
+            p01[j] = u * (a01 - k1[j] * a00);
+            p11[j] = u * (a11 - k1[j] * a01) + (1.0f - u) * INITIAL_VELOCITY_VARIANCE;
+        }
+
+        // Restarting lanes take the measurement and no velocity
+        alignas(32) float value[CHANNELS][LANES], rate[CHANNELS][LANES];
+        for (int c = 0; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                const float predicted = state.value[c][j] + state.rate[c][j] * dt;
+                const float innovation = x[c][j] - predicted;
+                const float u = update[j];
+                value[c][j] = u * (predicted + k0[j] * innovation) + (1.0f - u) * x[c][j];
+                rate[c][j] = u * (state.rate[c][j] + k1[j] * innovation);
+            }
+        }
+
+        // Written through locals for the same reason as in OneEuro()
+        alignas(32) float prediction[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            prediction[j] = m_predictionS[j];
+        }
+        for (int c = 0; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                out[c][j] = value[c][j] + rate[c][j] * prediction[j];
+            }
+        }
+        for (int c = 0; c < CHANNELS; ++c) {
+            for (int j = 0; j < LANES; ++j) {
+                state.value[c][j] = value[c][j];
+                state.rate[c][j] = rate[c][j];
+            }
+        }
+        for (int j = 0; j < LANES; ++j) {
+            state.p00[j] = p00[j];
+            state.p01[j] = p01[j];
+            state.p11[j] = p11[j];
+        }
+    }
+
+    static constexpr float INITIAL_VELOCITY_VARIANCE = 1.0f;  // (m/s)^2
+
+    FilterMode m_mode = FilterMode::Off;
+    HandState m_state[HAND_COUNT];
+    Stats m_stats;
+
+    // Per-lane parameters, expanded from the joint groups
+    alignas(32) float m_minCutoffHz[LANES] = {};
+    alignas(32) float m_beta[LANES] = {};
+    alignas(32) float m_derivativeAlphaTau[LANES] = {};
+    alignas(32) float m_lagCompensation[LANES] = {};
+    alignas(32) float m_measurementVariance[LANES] = {};
+    alignas(32) float m_accelerationVariance[LANES] = {};
+    alignas(32) float m_predictionS[LANES] = {};
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "hand_frame_soa.h"
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HANDTRACKING_X86_KERNELS 1
+#endif
+
+// ============================================================================
+// Per-frame derived joint quantities
+// ============================================================================
+// Everything consumers commonly derive from a frame, computed for both
+// hands in one pass over the SoA frame (hand_frame_soa.h):
+//   - joint poses relative to the wrist
+//   - joint poses in another reference frame
+//   - bone lengths (joint to parent joint)
+//   - bend angles at each joint and per-finger curl (sum of bend angles)
+//
+// The kernel source (joint_kernels_impl.h) is compiled three times: scalar,
+// SSE2 (4 lanes, always present on x86-64) and AVX2+FMA (8 lanes). The
+// widest set the CPU supports is picked once at runtime.
+// ============================================================================
+
+struct alignas(32) HandFrameDerived {
+    struct alignas(32) Hand {
+        // Wrist-relative joint poses; localValid needs the joint and the wrist
+        float localPx[SOA_LANES], localPy[SOA_LANES], localPz[SOA_LANES];
+        float localQx[SOA_LANES], localQy[SOA_LANES], localQz[SOA_LANES], localQw[SOA_LANES];
+        float localValid[SOA_LANES];
+
+        // Joint poses in the reference frame (valid where the input is)
+        float refPx[SOA_LANES], refPy[SOA_LANES], refPz[SOA_LANES];
+        float refQx[SOA_LANES], refQy[SOA_LANES], refQz[SOA_LANES], refQw[SOA_LANES];
+
+        // Meters; zero for the wrist and for invalid bones
+        float boneLength[SOA_LANES];
+        float boneValid[SOA_LANES];
+
+        // Radians between the incoming and outgoing bone (0 = straight)
+        float bendAngle[SOA_LANES];
+        float bendValid[SOA_LANES];
+
+        // Radians, sum of the bend angles in FINGER_CURL_JOINTS
+        float fingerCurl[FINGER_COUNT];
+        bool fingerCurlValid[FINGER_COUNT];
+    } hands[HAND_COUNT];
+};
+
+enum class JointKernelIsa : uint32_t {
+    Scalar = 0,
+    Sse2 = 1,
+    Avx2 = 2,
+};
+
+inline const char* JointKernelIsaName(JointKernelIsa isa) {
+    switch (isa) {
+        case JointKernelIsa::Scalar: return "scalar";
+        case JointKernelIsa::Sse2: return "sse2";
+        case JointKernelIsa::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+inline bool ParseJointKernelIsa(const std::string& name, JointKernelIsa& isa) {
+    for (JointKernelIsa candidate : {JointKernelIsa::Scalar, JointKernelIsa::Sse2, JointKernelIsa::Avx2}) {
+        if (name == JointKernelIsaName(candidate)) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool IsJointKernelIsaSupported(JointKernelIsa isa) {
+    switch (isa) {
+        case JointKernelIsa::Scalar:
+            return true;
+#ifdef HANDTRACKING_X86_KERNELS
+        case JointKernelIsa::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case JointKernelIsa::Avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+        default:
+            return false;
+    }
+}
+
+inline JointKernelIsa DetectJointKernelIsa() {
+    if (IsJointKernelIsaSupported(JointKernelIsa::Avx2)) {
+        return JointKernelIsa::Avx2;
+    }
+    if (IsJointKernelIsaSupported(JointKernelIsa::Sse2)) {
+        return JointKernelIsa::Sse2;
+    }
+    return JointKernelIsa::Scalar;
+}
+
+// ---------------------------------------------------------------------------
+// Scalar
+// ---------------------------------------------------------------------------
+namespace joint_kernels_scalar {
+struct Ops {
+    using V = float;
+    using M = bool;
+    static constexpr int WIDTH = 1;
+    static V Load(const float* p) { return *p; }
+    static void Store(float* p, V v) { *p = v; }
+    static V Set(float f) { return f; }
+    static V Add(V a, V b) { return a + b; }
+    static V Sub(V a, V b) { return a - b; }
+    static V Mul(V a, V b) { return a * b; }
+    static V MulAdd(V a, V b, V c) { return a * b + c; }
+    static V Div(V a, V b) { return a / b; }
+    static V Sqrt(V a) { return __builtin_sqrtf(a); }
+    static V Min(V a, V b) { return a < b ? a : b; }
+    static V Max(V a, V b) { return a > b ? a : b; }
+    static V Abs(V a) { return __builtin_fabsf(a); }
+    static M Less(V a, V b) { return a < b; }
+    static V Select(M m, V a, V b) { return m ? a : b; }
+};
+#include "joint_kernels_impl.h"
+}  // namespace joint_kernels_scalar
+
+#ifdef HANDTRACKING_X86_KERNELS
+// ---------------------------------------------------------------------------
+// SSE2, 4 lanes
+// ---------------------------------------------------------------------------
+namespace joint_kernels_sse2 {
+struct Ops {
+    using V = __m128;
+    using M = __m128;
+    static constexpr int WIDTH = 4;
+    static V Load(const float* p) { return _mm_load_ps(p); }
+    static void Store(float* p, V v) { _mm_store_ps(p, v); }
+    static V Set(float f) { return _mm_set1_ps(f); }
+    static V Add(V a, V b) { return _mm_add_ps(a, b); }
+    static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static V Div(V a, V b) { return _mm_div_ps(a, b); }
+    static V Sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V Min(V a, V b) { return _mm_min_ps(a, b); }
+    static V Max(V a, V b) { return _mm_max_ps(a, b); }
+    static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static M Less(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V Select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+#include "joint_kernels_impl.h"
+}  // namespace joint_kernels_sse2
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA, 8 lanes
+// ---------------------------------------------------------------------------
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace joint_kernels_avx2 {
+struct Ops {
+    using V = __m256;
+    using M = __m256;
+    static constexpr int WIDTH = 8;
+    static V Load(const float* p) { return _mm256_load_ps(p); }
+    static void Store(float* p, V v) { _mm256_store_ps(p, v); }
+    static V Set(float f) { return _mm256_set1_ps(f); }
+    static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V Sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static M Less(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V Select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+};
+#include "joint_kernels_impl.h"
+}  // namespace joint_kernels_avx2
+#pragma GCC pop_options
+#endif
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+// Picks a kernel once at construction; Compute() is then a single indirect
+// call per frame. Instances hold no per-frame state, so one can be shared
+// by any number of consumer threads.
+class JointKernels {
+public:
+    JointKernels() : JointKernels(DetectJointKernelIsa()) {}
+
+    // Falls back to the detected set if the requested one is not supported
+    explicit JointKernels(JointKernelIsa isa) {
+        if (!IsJointKernelIsaSupported(isa)) {
+            isa = DetectJointKernelIsa();
+        }
+        m_isa = isa;
+        switch (isa) {
+#ifdef HANDTRACKING_X86_KERNELS
+            case JointKernelIsa::Avx2: m_compute = joint_kernels_avx2::ComputeDerived; break;
+            case JointKernelIsa::Sse2: m_compute = joint_kernels_sse2::ComputeDerived; break;
+#endif
+            default: m_compute = joint_kernels_scalar::ComputeDerived; break;
+        }
+    }
+
+    JointKernelIsa GetIsa() const { return m_isa; }
+    const char* GetIsaName() const { return JointKernelIsaName(m_isa); }
+
+    // reference is the pose of the app's reference space in the target
+    // frame; pass an identity pose if only the other quantities are needed.
+    void Compute(const HandFrameSoA& soa, const XrPosef& reference, HandFrameDerived& out) const {
+        m_compute(soa, reference, out);
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            HandFrameDerived::Hand& derived = out.hands[hand];
+            for (int finger = 0; finger < FINGER_COUNT; ++finger) {
+                float curl = 0.0f;
+                bool valid = true;
+                for (int j = FINGER_CURL_JOINTS[finger].first; j <= FINGER_CURL_JOINTS[finger].last; ++j) {
+                    curl += derived.bendAngle[j];
+                    valid = valid && derived.bendValid[j] != 0.0f;
+                }
+                derived.fingerCurl[finger] = curl;
+                derived.fingerCurlValid[finger] = valid;
+            }
+        }
+    }
+
+    // Transposes and computes in one call
+    void Compute(const HandFrame& frame, const XrPosef& reference, HandFrameSoA& soa, HandFrameDerived& out) const {
+        ToSoA(frame, soa);
+        Compute(soa, reference, out);
+    }
+
+private:
+    using ComputeFunction = void (*)(const HandFrameSoA&, const XrPosef&, HandFrameDerived&);
+    JointKernelIsa m_isa = JointKernelIsa::Scalar;
+    ComputeFunction m_compute = joint_kernels_scalar::ComputeDerived;
+};
@@ -0,0 +1,119 @@
+// Body of the per-frame joint kernels. No #pragma once: joint_kernels.h
+// includes this once per instruction set, inside a namespace that defines
+// Ops (the vector type and its operations) and, for the wider sets, under
+// a #pragma GCC target so the same source is compiled for each one.
+
+using V = Ops::V;
+
+// v' = v + 2w(u x v) + 2u x (u x v), u = q.xyz (same as QuatRotate)
+inline void RotateV(V qx, V qy, V qz, V qw, V vx, V vy, V vz, V& ox, V& oy, V& oz) {
+    const V two = Ops::Set(2.0f);
+    const V tx = Ops::Mul(two, Ops::Sub(Ops::Mul(qy, vz), Ops::Mul(qz, vy)));
+    const V ty = Ops::Mul(two, Ops::Sub(Ops::Mul(qz, vx), Ops::Mul(qx, vz)));
+    const V tz = Ops::Mul(two, Ops::Sub(Ops::Mul(qx, vy), Ops::Mul(qy, vx)));
+    ox = Ops::Add(Ops::MulAdd(qw, tx, vx), Ops::Sub(Ops::Mul(qy, tz), Ops::Mul(qz, ty)));
+    oy = Ops::Add(Ops::MulAdd(qw, ty, vy), Ops::Sub(Ops::Mul(qz, tx), Ops::Mul(qx, tz)));
+    oz = Ops::Add(Ops::MulAdd(qw, tz, vz), Ops::Sub(Ops::Mul(qx, ty), Ops::Mul(qy, tx)));
+}
+
+// a * b (same as QuatMultiply)
+inline void MultiplyV(V ax, V ay, V az, V aw, V bx, V by, V bz, V bw, V& ox, V& oy, V& oz, V& ow) {
+    ox = Ops::Sub(Ops::Add(Ops::MulAdd(aw, bx, Ops::Mul(ax, bw)), Ops::Mul(ay, bz)), Ops::Mul(az, by));
+    oy = Ops::Add(Ops::Sub(Ops::Mul(aw, by), Ops::Mul(ax, bz)), Ops::MulAdd(ay, bw, Ops::Mul(az, bx)));
+    oz = Ops::Add(Ops::Sub(Ops::MulAdd(aw, bz, Ops::Mul(ax, by)), Ops::Mul(ay, bx)), Ops::Mul(az, bw));
+    ow = Ops::Sub(Ops::Sub(Ops::Sub(Ops::Mul(aw, bw), Ops::Mul(ax, bx)), Ops::Mul(ay, by)), Ops::Mul(az, bz));
+}
+
+// acos for x in [-1, 1] (Abramowitz & Stegun 4.4.45, error < 7e-5 rad)
+inline V AcosV(V x) {
+    const V ax = Ops::Abs(x);
+    V poly = Ops::Set(-0.0187293f);
+    poly = Ops::MulAdd(poly, ax, Ops::Set(0.0742610f));
+    poly = Ops::MulAdd(poly, ax, Ops::Set(-0.2121144f));
+    poly = Ops::MulAdd(poly, ax, Ops::Set(1.5707288f));
+    const V r = Ops::Mul(Ops::Sqrt(Ops::Sub(Ops::Set(1.0f), ax)), poly);
+    return Ops::Select(Ops::Less(x, Ops::Set(0.0f)), Ops::Sub(Ops::Set(3.14159265f), r), r);
+}
+
+inline void ComputeHand(const HandFrameSoA::Hand& in, const XrPosef& reference, HandFrameDerived::Hand& out) {
+    // Wrist inverse and reference pose, broadcast to every lane
+    const V wx = Ops::Set(-in.wrist.orientation.x);
+    const V wy = Ops::Set(-in.wrist.orientation.y);
+    const V wz = Ops::Set(-in.wrist.orientation.z);
+    const V ww = Ops::Set(in.wrist.orientation.w);
+    const V wpx = Ops::Set(in.wrist.position.x);
+    const V wpy = Ops::Set(in.wrist.position.y);
+    const V wpz = Ops::Set(in.wrist.position.z);
+    const V wristValid = Ops::Set(in.wristValid ? 1.0f : 0.0f);
+    const V rx = Ops::Set(reference.orientation.x);
+    const V ry = Ops::Set(reference.orientation.y);
+    const V rz = Ops::Set(reference.orientation.z);
+    const V rw = Ops::Set(reference.orientation.w);
+    const V rpx = Ops::Set(reference.position.x);
+    const V rpy = Ops::Set(reference.position.y);
+    const V rpz = Ops::Set(reference.position.z);
+    const V zero = Ops::Set(0.0f);
+    const V one = Ops::Set(1.0f);
+    const V epsilon = Ops::Set(1e-12f);
+
+    for (int j = 0; j < SOA_LANES; j += Ops::WIDTH) {
+        const V px = Ops::Load(in.px + j), py = Ops::Load(in.py + j), pz = Ops::Load(in.pz + j);
+        const V qx = Ops::Load(in.qx + j), qy = Ops::Load(in.qy + j), qz = Ops::Load(in.qz + j), qw = Ops::Load(in.qw + j);
+        const V positionValid = Ops::Load(in.positionValid + j);
+        const V orientationValid = Ops::Load(in.orientationValid + j);
+        V ox, oy, oz, ow;
+
+        // Wrist-relative: conj(wrist) * (p - wrist.p), conj(wrist) * q
+        RotateV(wx, wy, wz, ww, Ops::Sub(px, wpx), Ops::Sub(py, wpy), Ops::Sub(pz, wpz), ox, oy, oz);
+        Ops::Store(out.localPx + j, ox);
+        Ops::Store(out.localPy + j, oy);
+        Ops::Store(out.localPz + j, oz);
+        MultiplyV(wx, wy, wz, ww, qx, qy, qz, qw, ox, oy, oz, ow);
+        Ops::Store(out.localQx + j, ox);
+        Ops::Store(out.localQy + j, oy);
+        Ops::Store(out.localQz + j, oz);
+        Ops::Store(out.localQw + j, ow);
+        Ops::Store(out.localValid + j, Ops::Mul(Ops::Mul(positionValid, orientationValid), wristValid));
+
+        // Reference frame: reference.p + reference * p, reference * q
+        RotateV(rx, ry, rz, rw, px, py, pz, ox, oy, oz);
+        Ops::Store(out.refPx + j, Ops::Add(ox, rpx));
+        Ops::Store(out.refPy + j, Ops::Add(oy, rpy));
+        Ops::Store(out.refPz + j, Ops::Add(oz, rpz));
+        MultiplyV(rx, ry, rz, rw, qx, qy, qz, qw, ox, oy, oz, ow);
+        Ops::Store(out.refQx + j, ox);
+        Ops::Store(out.refQy + j, oy);
+        Ops::Store(out.refQz + j, oz);
+        Ops::Store(out.refQw + j, ow);
+
+        // Bone from the parent joint
+        const V ax = Ops::Sub(px, Ops::Load(in.parentPx + j));
+        const V ay = Ops::Sub(py, Ops::Load(in.parentPy + j));
+        const V az = Ops::Sub(pz, Ops::Load(in.parentPz + j));
+        const V a2 = Ops::MulAdd(ax, ax, Ops::MulAdd(ay, ay, Ops::Mul(az, az)));
+        const V boneValid = Ops::Mul(positionValid, Ops::Load(in.parentValid + j));
+        Ops::Store(out.boneLength + j, Ops::Mul(Ops::Sqrt(a2), boneValid));
+        Ops::Store(out.boneValid + j, boneValid);
+
+        // Bend: angle between the incoming bone and the bone to the child.
+        // Zero-length bones (wrist, palm, tips) have no bend.
+        const V bx = Ops::Sub(Ops::Load(in.childPx + j), px);
+        const V by = Ops::Sub(Ops::Load(in.childPy + j), py);
+        const V bz = Ops::Sub(Ops::Load(in.childPz + j), pz);
+        const V b2 = Ops::MulAdd(bx, bx, Ops::MulAdd(by, by, Ops::Mul(bz, bz)));
+        const V dot = Ops::MulAdd(ax, bx, Ops::MulAdd(ay, by, Ops::Mul(az, bz)));
+        const V denominator2 = Ops::Mul(a2, b2);
+        const V cosine = Ops::Div(dot, Ops::Sqrt(Ops::Max(denominator2, epsilon)));
+        const V angle = AcosV(Ops::Min(Ops::Max(cosine, Ops::Set(-1.0f)), one));
+        const V bendValid = Ops::Select(Ops::Less(epsilon, denominator2),
+                                        Ops::Mul(boneValid, Ops::Load(in.childValid + j)), zero);
+        Ops::Store(out.bendAngle + j, Ops::Mul(angle, bendValid));
+        Ops::Store(out.bendValid + j, bendValid);
+    }
+}
+
+inline void ComputeDerived(const HandFrameSoA& soa, const XrPosef& reference, HandFrameDerived& out) {
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        ComputeHand(soa.hands[hand], reference, out.hands[hand]);
+    }
+}
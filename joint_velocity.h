@@ -0,0 +1,122 @@
+#pragma once
+
+#include "hand_frame.h"
+#include <cstdint>
+
+// Fallback joint velocities for runtimes that do not fill
+// XrHandJointVelocitiesEXT: finite differences against the previous
+// sample, computed once per frame on the sampler thread.
+//
+// The previous sample is kept as structure-of-arrays (one array per
+// component, padded from 26 to 32 lanes) so each pass below is a
+// straight, branch-free loop over whole vectors that the compiler can
+// vectorize: GCC 12 and later do so at -O2, older GCC needs -O3 (or
+// -ftree-vectorize).
+//
+// Angular velocity uses the small-angle form
+// w = 2 * vec(q * conj(q_prev)) / dt, which is within 1% of the exact
+// value up to 30 degrees of rotation per sample.
+class JointVelocityEstimator {
+public:
+    // Estimates velocities for one hand from its joints located at timeNs.
+    // Joints that were not valid in both samples get no velocity flags.
+    void Estimate(int hand, const HandFrame::Hand& data, int64_t timeNs, XrHandJointVelocityEXT* velocities) {
+        History& history = m_history[hand];
+        const bool located = XR_SUCCEEDED(data.result) && data.isActive;
+        const int64_t dtNs = timeNs - history.timeNs;
+        const bool usable = located && history.valid && dtNs > 0 && dtNs <= MAX_INTERVAL_NS;
+        const float invDt = usable ? 1e9f / static_cast<float>(dtNs) : 0.0f;
+
+        alignas(32) float px[LANES] = {}, py[LANES] = {}, pz[LANES] = {};
+        alignas(32) float qx[LANES] = {}, qy[LANES] = {}, qz[LANES] = {}, qw[LANES] = {};
+        alignas(32) float positionValid[LANES] = {}, orientationValid[LANES] = {};
+        for (int j = 0; j < N; ++j) {
+            const XrHandJointLocationEXT& joint = data.joints[j];
+            px[j] = joint.pose.position.x;
+            py[j] = joint.pose.position.y;
+            pz[j] = joint.pose.position.z;
+            qx[j] = joint.pose.orientation.x;
+            qy[j] = joint.pose.orientation.y;
+            qz[j] = joint.pose.orientation.z;
+            qw[j] = joint.pose.orientation.w;
+            positionValid[j] = (joint.locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT) ? 1.0f : 0.0f;
+            orientationValid[j] = (joint.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) ? 1.0f : 0.0f;
+        }
+
+        // Linear: (p - p_prev) / dt
+        alignas(32) float vx[LANES], vy[LANES], vz[LANES], linearValid[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            vx[j] = (px[j] - history.px[j]) * invDt;
+            vy[j] = (py[j] - history.py[j]) * invDt;
+            vz[j] = (pz[j] - history.pz[j]) * invDt;
+            linearValid[j] = positionValid[j] * history.positionValid[j];
+        }
+
+        // Angular: d = q * conj(q_prev), flipped to the short way round
+        alignas(32) float wx[LANES], wy[LANES], wz[LANES], angularValid[LANES];
+        for (int j = 0; j < LANES; ++j) {
+            const float ax = qx[j], ay = qy[j], az = qz[j], aw = qw[j];
+            const float bx = -history.qx[j], by = -history.qy[j], bz = -history.qz[j], bw = history.qw[j];
+            const float dx = aw * bx + ax * bw + ay * bz - az * by;
+            const float dy = aw * by - ax * bz + ay * bw + az * bx;
+            const float dz = aw * bz + ax * by - ay * bx + az * bw;
+            const float dw = aw * bw - ax * bx - ay * by - az * bz;
+            const float scale = (dw < 0.0f ? -2.0f : 2.0f) * invDt;
+            wx[j] = dx * scale;
+            wy[j] = dy * scale;
+            wz[j] = dz * scale;
+            angularValid[j] = orientationValid[j] * history.orientationValid[j];
+        }
+
+        const XrSpaceVelocityFlags usableMask = usable ? ~XrSpaceVelocityFlags(0) : 0;
+        for (int j = 0; j < N; ++j) {
+            XrHandJointVelocityEXT& velocity = velocities[j];
+            velocity.velocityFlags = ((linearValid[j] != 0.0f ? XR_SPACE_VELOCITY_LINEAR_VALID_BIT : 0) |
+                                      (angularValid[j] != 0.0f ? XR_SPACE_VELOCITY_ANGULAR_VALID_BIT : 0)) & usableMask;
+            velocity.linearVelocity = {vx[j], vy[j], vz[j]};
+            velocity.angularVelocity = {wx[j], wy[j], wz[j]};
+        }
+
+        // Becomes the previous sample for the next call
+        const float locatedMask = located ? 1.0f : 0.0f;
+        for (int j = 0; j < LANES; ++j) {
+            history.px[j] = px[j];
+            history.py[j] = py[j];
+            history.pz[j] = pz[j];
+            history.qx[j] = qx[j];
+            history.qy[j] = qy[j];
+            history.qz[j] = qz[j];
+            history.qw[j] = qw[j];
+            history.positionValid[j] = positionValid[j] * locatedMask;
+            history.orientationValid[j] = orientationValid[j] * locatedMask;
+        }
+        history.timeNs = timeNs;
+        history.valid = located;
+    }
+
+    void Reset() {
+        for (History& history : m_history) {
+            history.valid = false;
+        }
+    }
+
+private:
+    static constexpr int N = XR_HAND_JOINT_COUNT_EXT;
+    static constexpr int LANES = 32;
+    // Older samples are too far apart to difference (e.g. after a dropout)
+    static constexpr int64_t MAX_INTERVAL_NS = 250000000;
+
+    struct History {
+        bool valid = false;
+        int64_t timeNs = 0;
+        alignas(32) float px[LANES] = {};
+        alignas(32) float py[LANES] = {};
+        alignas(32) float pz[LANES] = {};
+        alignas(32) float qx[LANES] = {};
+        alignas(32) float qy[LANES] = {};
+        alignas(32) float qz[LANES] = {};
+        alignas(32) float qw[LANES] = {};
+        alignas(32) float positionValid[LANES] = {};
+        alignas(32) float orientationValid[LANES] = {};
+    } m_history[HAND_COUNT];
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+// Fixed-size log-linear histogram in the style of HdrHistogram.
+//
+// Values (nanoseconds by convention) are kept with SUB_BUCKET_BITS bits of
+// precision, i.e. every power-of-two range is split into 32 linear
+// buckets, which bounds the relative error of any percentile to ~3%.
+// Record() is a few integer ops and never allocates, so it is safe on the
+// sampling thread. Not thread-safe: use one histogram per writer and
+// Merge() them for reporting.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+    static constexpr int MAX_VALUE_BITS = 44;  // ~4.9 hours in ns; larger values are clamped
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1);
+
+    void Record(uint64_t value) {
+        m_counts[BucketIndex(value)]++;
+        m_count++;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    void Reset() {
+        m_counts.fill(0);
+        m_count = 0;
+        m_sum = 0;
+        m_min = std::numeric_limits<uint64_t>::max();
+        m_max = 0;
+    }
+
+    uint64_t Count() const { return m_count; }
+    uint64_t Min() const { return m_count ? m_min : 0; }
+    uint64_t Max() const { return m_max; }
+    double Mean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    // Upper bound of the bucket holding the given percentile (0-100),
+    // clamped to the exact maximum
+    uint64_t ValueAtPercentile(double percentile) const {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * m_count + 0.5);
+        target = std::max<uint64_t>(1, std::min(target, m_count));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_counts[i];
+            if (seen >= target) {
+                return std::min(BucketUpperBound(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    // Read-only access to the buckets, for exporters
+    size_t BucketCountAt(size_t index) const { return m_counts[index]; }
+    static uint64_t BucketUpperBound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        uint64_t exponent = index / SUB_BUCKET_COUNT - 1;
+        uint64_t sub = index % SUB_BUCKET_COUNT;
+        return ((SUB_BUCKET_COUNT + sub + 1) << exponent) - 1;
+    }
+
+    // One line: count, mean, p50/p99/p99.9, max. Values are divided by
+    // unitScale for display (e.g. 1000 to print ns values as us).
+    void Print(std::ostream& out, const std::string& name, const char* unit = "us", double unitScale = 1000.0) const {
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+            << " n=" << std::setw(9) << m_count
+            << "  mean " << std::setw(9) << Mean() / unitScale
+            << "  p50 " << std::setw(9) << ValueAtPercentile(50.0) / unitScale
+            << "  p99 " << std::setw(9) << ValueAtPercentile(99.0) / unitScale
+            << "  p99.9 " << std::setw(9) << ValueAtPercentile(99.9) / unitScale
+            << "  max " << std::setw(9) << Max() / unitScale
+            << " " << unit << std::endl;
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> m_counts{};
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = std::numeric_limits<uint64_t>::max();
+    uint64_t m_max = 0;
+
+    static size_t BucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        if (msb >= MAX_VALUE_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        int exponent = msb - SUB_BUCKET_BITS;
+        uint64_t sub = (value >> exponent) - SUB_BUCKET_COUNT;
+        return static_cast<size_t>(SUB_BUCKET_COUNT * (exponent + 1) + sub);
+    }
+};
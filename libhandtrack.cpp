@@ -0,0 +1,187 @@
+#define HT_BUILDING_LIBRARY
+#include "libhandtrack.h"
+#include "app_options.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+
+// The C frame is HandFrame seen through C types, so frames are handed out
+// by pointer instead of being converted
+static_assert(sizeof(ht_frame) == sizeof(HandFrame), "ht_frame must match HandFrame");
+static_assert(sizeof(ht_hand) == sizeof(HandFrame::Hand), "ht_hand must match HandFrame::Hand");
+static_assert(offsetof(ht_frame, frameIndex) == offsetof(HandFrame, frameIndex), "ht_frame layout");
+static_assert(offsetof(ht_frame, sampleTimeNs) == offsetof(HandFrame, sampleTimeNs), "ht_frame layout");
+static_assert(offsetof(ht_frame, locateTime) == offsetof(HandFrame, locateTime), "ht_frame layout");
+static_assert(offsetof(ht_frame, hands) == offsetof(HandFrame, hands), "ht_frame layout");
+static_assert(offsetof(ht_hand, result) == offsetof(HandFrame::Hand, result), "ht_hand layout");
+static_assert(offsetof(ht_hand, isActive) == offsetof(HandFrame::Hand, isActive), "ht_hand layout");
+static_assert(offsetof(ht_hand, jointCount) == offsetof(HandFrame::Hand, jointCount), "ht_hand layout");
+static_assert(offsetof(ht_hand, joints) == offsetof(HandFrame::Hand, joints), "ht_hand layout");
+static_assert(offsetof(ht_hand, velocitySource) == offsetof(HandFrame::Hand, velocitySource), "ht_hand layout");
+static_assert(offsetof(ht_hand, velocities) == offsetof(HandFrame::Hand, velocities), "ht_hand layout");
+static_assert(HT_HAND_COUNT == HAND_COUNT, "hand count");
+
+static const ht_frame* ToCFrame(const HandFrame* frame) {
+    return reinterpret_cast<const ht_frame*>(frame);
+}
+
+struct ht_context {
+    std::unique_ptr<HandTrackingOnlyApp> app;
+    std::thread loop;                // runs HandTrackingOnlyApp::Run()
+    std::atomic<bool> running{false};
+    ht_frame_callback callback = nullptr;
+    void* callbackUserData = nullptr;
+};
+
+// Adapts the C callback to the app's; userData is the context
+static void ForwardFrame(const HandFrame& frame, void* userData) {
+    ht_context* context = static_cast<ht_context*>(userData);
+    context->callback(ToCFrame(&frame), context->callbackUserData);
+}
+
+// Joins a loop that ended by itself, so the context counts as stopped
+static void JoinFinishedLoop(ht_context* context) {
+    if (context->loop.joinable() && !context->running.load()) {
+        context->loop.join();
+    }
+}
+
+extern "C" {
+
+uint32_t ht_api_version(void) {
+    return HT_API_VERSION;
+}
+
+const char* ht_result_string(ht_result result) {
+    switch (result) {
+        case HT_SUCCESS: return "success";
+        case HT_NO_FRAME: return "no frame yet";
+        case HT_HELP_SHOWN: return "usage shown";
+        case HT_ERROR_INVALID_ARGUMENT: return "invalid argument";
+        case HT_ERROR_INITIALIZATION_FAILED: return "initialization failed";
+        case HT_ERROR_RUNNING: return "tracking is running";
+        case HT_ERROR_START_FAILED: return "start failed";
+        default: return "unknown result";
+    }
+}
+
+// Tears down whatever Start() or Run() got going before they threw; a
+// second failure during the teardown is swallowed, there is nothing left
+// to try
+static void StopAfterFailure(ht_context* context) {
+    try {
+        context->app->Stop();
+    } catch (const std::exception&) {
+    }
+}
+
+ht_result ht_create(int argc, const char* const* argv, ht_context** context) {
+    if (context == nullptr || argc < 0 || (argc > 0 && argv == nullptr)) {
+        return HT_ERROR_INVALID_ARGUMENT;
+    }
+    *context = nullptr;
+    AppConfig config;
+    bool helpShown = false;
+    if (!ParseArguments(argc, argv, config, helpShown)) {
+        return helpShown ? HT_HELP_SHOWN : HT_ERROR_INVALID_ARGUMENT;
+    }
+    try {
+        std::unique_ptr<ht_context> created(new ht_context);
+        created->app = std::make_unique<HandTrackingOnlyApp>(config);
+        if (!created->app->Initialize()) {
+            created->app->Shutdown();
+            return HT_ERROR_INITIALIZATION_FAILED;
+        }
+        *context = created.release();
+        return HT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << "libhandtrack: " << e.what() << std::endl;
+        return HT_ERROR_INITIALIZATION_FAILED;
+    }
+}
+
+ht_result ht_set_frame_callback(ht_context* context, ht_frame_callback callback, void* user_data) {
+    if (context == nullptr) {
+        return HT_ERROR_INVALID_ARGUMENT;
+    }
+    JoinFinishedLoop(context);
+    if (context->loop.joinable()) {
+        return HT_ERROR_RUNNING;
+    }
+    context->callback = callback;
+    context->callbackUserData = user_data;
+    context->app->SetFrameCallback(callback != nullptr ? &ForwardFrame : nullptr, context);
+    return HT_SUCCESS;
+}
+
+ht_result ht_start(ht_context* context) {
+    if (context == nullptr) {
+        return HT_ERROR_INVALID_ARGUMENT;
+    }
+    JoinFinishedLoop(context);
+    if (context->loop.joinable()) {
+        return HT_ERROR_RUNNING;
+    }
+    context->app->ClearStopRequest();
+    // Start() starts threads and may throw, and so may Run() on the loop
+    // thread; no exception may leave through the C API or end the process,
+    // and nothing may keep running after one
+    try {
+        if (!context->app->Start()) {
+            return HT_ERROR_START_FAILED;
+        }
+        context->running.store(true);
+        context->loop = std::thread([context] {
+            try {
+                context->app->Run();
+            } catch (const std::exception& e) {
+                std::cerr << "libhandtrack: " << e.what() << std::endl;
+                StopAfterFailure(context);
+            }
+            context->running.store(false);
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "libhandtrack: " << e.what() << std::endl;
+        context->running.store(false);
+        StopAfterFailure(context);
+        return HT_ERROR_START_FAILED;
+    }
+    return HT_SUCCESS;
+}
+
+int ht_is_running(const ht_context* context) {
+    return context != nullptr && context->running.load() ? 1 : 0;
+}
+
+ht_result ht_get_latest_frame(ht_context* context, const ht_frame** frame) {
+    if (context == nullptr || frame == nullptr) {
+        return HT_ERROR_INVALID_ARGUMENT;
+    }
+    const HandFrame* latest = context->app->ReadLatestFrame();
+    *frame = ToCFrame(latest);
+    return latest != nullptr ? HT_SUCCESS : HT_NO_FRAME;
+}
+
+ht_result ht_stop(ht_context* context) {
+    if (context == nullptr) {
+        return HT_ERROR_INVALID_ARGUMENT;
+    }
+    context->app->RequestStop();
+    if (context->loop.joinable()) {
+        context->loop.join();
+    }
+    return HT_SUCCESS;
+}
+
+void ht_shutdown(ht_context* context) {
+    if (context == nullptr) {
+        return;
+    }
+    ht_stop(context);
+    context->app->Shutdown();
+    delete context;
+}
+
+}  // extern "C"
@@ -0,0 +1,128 @@
+#ifndef LIBHANDTRACK_H
+#define LIBHANDTRACK_H
+
+/*
+ * libhandtrack - in-process hand tracking
+ * ============================================================================
+ * C API of the tracking app as a shared library (libhandtrack.so), for
+ * engines that want joint data in-process instead of reading it from
+ * another process's stdout, shared memory or UDP stream.
+ *
+ *   ht_context* context = NULL;
+ *   const char* options[] = {"my-engine", "--rate", "90", "--filter", "one-euro"};
+ *   if (ht_create(5, options, &context) == HT_SUCCESS && ht_start(context) == HT_SUCCESS) {
+ *       const ht_frame* frame = NULL;
+ *       while (running) {
+ *           if (ht_get_latest_frame(context, &frame) == HT_SUCCESS) { ... }
+ *       }
+ *   }
+ *   ht_shutdown(context);
+ *
+ * Options are the command-line options of test_handtracking_only (argv[0]
+ * is only used in messages). ht_create() sets up the OpenXR instance,
+ * session and hand trackers; ht_start() starts sampling on a background
+ * thread, ht_stop() stops it again, and ht_shutdown() releases
+ * everything. The test app is itself a client of this API.
+ *
+ * Frames are delivered without copying, either way:
+ *   - pull: ht_get_latest_frame() returns a pointer to the newest frame.
+ *     It stays valid and unchanged until the next call. Only one thread
+ *     may pull at a time.
+ *   - push: a callback registered with ht_set_frame_callback() runs on the
+ *     sampler thread with every frame. It must return quickly and must not
+ *     call back into the library; it delays the next sample otherwise.
+ * ============================================================================
+ */
+
+#include <stdint.h>
+#include <openxr/openxr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(HT_BUILDING_LIBRARY)
+#define HT_API __attribute__((visibility("default")))
+#else
+#define HT_API
+#endif
+
+/* Changes whenever a declaration in this header changes incompatibly */
+#define HT_API_VERSION 1
+
+#define HT_HAND_COUNT 2 /* index 0 = left, 1 = right */
+
+typedef enum ht_result {
+    HT_SUCCESS = 0,
+    HT_NO_FRAME = 1,                     /* nothing sampled yet */
+    HT_HELP_SHOWN = 2,                   /* ht_create() printed the usage, no context was created */
+    HT_ERROR_INVALID_ARGUMENT = -1,      /* null pointer or invalid option */
+    HT_ERROR_INITIALIZATION_FAILED = -2, /* OpenXR or stand-in setup failed */
+    HT_ERROR_RUNNING = -3,               /* not allowed while started */
+    HT_ERROR_START_FAILED = -4           /* a session or consumer could not be started */
+} ht_result;
+
+/* Where a hand's joint velocities came from */
+typedef enum ht_velocity_source {
+    HT_VELOCITY_NONE = 0,
+    HT_VELOCITY_RUNTIME = 1,
+    HT_VELOCITY_ESTIMATED = 2
+} ht_velocity_source;
+
+typedef struct ht_hand {
+    XrResult result;       /* of the locate call; joints are only meaningful on success */
+    XrBool32 isActive;
+    uint32_t jointCount;
+    XrHandJointLocationEXT joints[XR_HAND_JOINT_COUNT_EXT];
+    uint32_t velocitySource; /* ht_velocity_source */
+    XrHandJointVelocityEXT velocities[XR_HAND_JOINT_COUNT_EXT];
+} ht_hand;
+
+/* One sample of both hands (same layout as HandFrame in hand_frame.h) */
+typedef struct ht_frame {
+    uint64_t frameIndex;
+    int64_t sampleTimeNs; /* CLOCK_MONOTONIC time of the sample */
+    XrTime locateTime;    /* XrTime the joints were located for */
+    ht_hand hands[HT_HAND_COUNT];
+} ht_frame;
+
+typedef struct ht_context ht_context;
+
+typedef void (*ht_frame_callback)(const ht_frame* frame, void* user_data);
+
+/* HT_API_VERSION of the library actually loaded */
+HT_API uint32_t ht_api_version(void);
+
+HT_API const char* ht_result_string(ht_result result);
+
+/* Parses the options and initializes tracking; on success *context must
+ * be released with ht_shutdown(). --help prints the usage and returns
+ * HT_HELP_SHOWN without creating a context. */
+HT_API ht_result ht_create(int argc, const char* const* argv, ht_context** context);
+
+/* Registers (or, with NULL, removes) the per-frame callback. Only while
+ * stopped. */
+HT_API ht_result ht_set_frame_callback(ht_context* context, ht_frame_callback callback, void* user_data);
+
+/* Starts sampling and the event loop on a background thread */
+HT_API ht_result ht_start(ht_context* context);
+
+/* 1 from ht_start() until ht_stop(), or until tracking ended by itself
+ * (end of a replay, runtime asked the session to exit) */
+HT_API int ht_is_running(const ht_context* context);
+
+/* The newest frame, or HT_NO_FRAME before the first one. Also works after
+ * ht_stop(), returning the last frame. */
+HT_API ht_result ht_get_latest_frame(ht_context* context, const ht_frame** frame);
+
+/* Stops sampling and ends the session; ht_start() may follow again */
+HT_API ht_result ht_stop(ht_context* context);
+
+/* Stops if needed and releases the context (NULL is ignored) */
+HT_API void ht_shutdown(ht_context* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBHANDTRACK_H */
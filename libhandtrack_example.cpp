@@ -0,0 +1,88 @@
+#include "libhandtrack.h"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <vector>
+
+// ============================================================================
+// libhandtrack embedding example
+// ============================================================================
+// Runs hand tracking in-process through the C API and uses both delivery
+// paths: a frame callback that counts every sample on the sampler thread,
+// and a 10 Hz pull of the latest frame that prints both palms with the
+// capture-to-read latency. Options after the program name go to the
+// library unchanged (e.g. --synthetic --rate 90 --verbosity 0).
+// ============================================================================
+
+static std::atomic<bool> g_stopRequested{false};
+
+static void HandleStopSignal(int) {
+    g_stopRequested.store(true);
+}
+
+static int64_t MonotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Sampler thread: keep it short
+static void CountFrame(const ht_frame* frame, void* userData) {
+    std::atomic<uint64_t>* count = static_cast<std::atomic<uint64_t>*>(userData);
+    count->store(frame->frameIndex + 1, std::memory_order_relaxed);
+}
+
+int main(int argc, char* argv[]) {
+    if (ht_api_version() != HT_API_VERSION) {
+        std::cerr << "libhandtrack API version " << ht_api_version() << ", built against " << HT_API_VERSION << std::endl;
+        return -1;
+    }
+
+    ht_context* context = nullptr;
+    ht_result result = ht_create(argc, argv, &context);
+    if (result != HT_SUCCESS) {
+        std::cerr << "ht_create: " << ht_result_string(result) << std::endl;
+        return -1;
+    }
+
+    std::atomic<uint64_t> callbackFrames{0};
+    ht_set_frame_callback(context, &CountFrame, &callbackFrames);
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    result = ht_start(context);
+    if (result != HT_SUCCESS) {
+        std::cerr << "ht_start: " << ht_result_string(result) << std::endl;
+        ht_shutdown(context);
+        return -1;
+    }
+
+    while (!g_stopRequested.load() && ht_is_running(context)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const ht_frame* frame = nullptr;
+        if (ht_get_latest_frame(context, &frame) != HT_SUCCESS) {
+            continue;
+        }
+        double latencyMs = (MonotonicNowNs() - frame->sampleTimeNs) / 1e6;
+        std::cout << "[Pull] frame " << frame->frameIndex << " (callback saw " << callbackFrames.load() << ")"
+                  << ", latency " << std::fixed << std::setprecision(2) << latencyMs << " ms";
+        for (int hand = 0; hand < HT_HAND_COUNT; ++hand) {
+            const ht_hand& data = frame->hands[hand];
+            std::cout << "  " << (hand == 0 ? "LEFT" : "RIGHT") << ": ";
+            if (XR_SUCCEEDED(data.result) && data.isActive) {
+                const XrVector3f& palm = data.joints[XR_HAND_JOINT_PALM_EXT].pose.position;
+                std::cout << std::setprecision(3) << "(" << palm.x << ", " << palm.y << ", " << palm.z << ")";
+            } else {
+                std::cout << "inactive";
+            }
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    ht_shutdown(context);
+    return 0;
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "openxr_minimal.h"
+#include "hand_frame.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// ============================================================================
+// Tracking metrics
+// ============================================================================
+// Counters, gauges and histograms for the metrics endpoint
+// (metrics_server.h), rendered in the Prometheus text format.
+//
+// Every metric has exactly one writing thread (the sampler for per-frame
+// metrics, the main thread for interval ones). Writes are a relaxed load
+// and store rather than an atomic read-modify-write, so the sampler pays
+// no locked instruction. The endpoint thread reads whenever it is scraped;
+// a scrape may see one metric a frame ahead of another, which Prometheus
+// tolerates.
+// ============================================================================
+
+class MetricCounter {
+public:
+    void Add(uint64_t n = 1) {
+        m_value.store(m_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+class MetricGauge {
+public:
+    void Set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    double Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{0.0};
+};
+
+// Fixed buckets from 1 us to 50 ms, reported in seconds
+class MetricHistogram {
+public:
+    static constexpr int BUCKET_COUNT = 15;  // the last one is +Inf
+    static constexpr uint64_t BUCKET_BOUNDS_NS[BUCKET_COUNT - 1] = {
+        1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000,
+        1000000, 2000000, 5000000, 10000000, 50000000};
+
+    void Observe(uint64_t ns) {
+        int bucket = 0;
+        while (bucket < BUCKET_COUNT - 1 && ns > BUCKET_BOUNDS_NS[bucket]) {
+            bucket++;
+        }
+        m_buckets[bucket].Add();
+        m_count.Add();
+        m_sumNs.Add(ns);
+    }
+
+    uint64_t GetCount() const { return m_count.Get(); }
+    uint64_t GetSumNs() const { return m_sumNs.Get(); }
+    uint64_t GetBucket(int bucket) const { return m_buckets[bucket].Get(); }
+
+private:
+    MetricCounter m_buckets[BUCKET_COUNT];
+    MetricCounter m_count;
+    MetricCounter m_sumNs;
+};
+
+// Counts per XrResult. Slots are claimed on first use by the writer; a
+// result seen after all slots are taken is counted in a separate "other"
+// counter, so the per-result counts stay exact.
+class ResultCounters {
+public:
+    static constexpr int SLOT_COUNT = 16;
+
+    void Add(XrResult result) {
+        int used = m_used.load(std::memory_order_relaxed);
+        for (int i = 0; i < used; ++i) {
+            if (m_codes[i] == result) {
+                m_counts[i].Add();
+                return;
+            }
+        }
+        if (used < SLOT_COUNT) {
+            m_codes[used] = result;
+            m_counts[used].Add();
+            m_used.store(used + 1, std::memory_order_release);
+            return;
+        }
+        m_other.Add();
+    }
+
+    int GetUsed() const { return m_used.load(std::memory_order_acquire); }
+    XrResult GetResult(int slot) const { return m_codes[slot]; }
+    uint64_t GetCount(int slot) const { return m_counts[slot].Get(); }
+    uint64_t GetOtherCount() const { return m_other.Get(); }
+
+private:
+    XrResult m_codes[SLOT_COUNT] = {};
+    MetricCounter m_counts[SLOT_COUNT];
+    MetricCounter m_other;
+    std::atomic<int> m_used{0};
+};
+
+// What the sampler records per frame, and what the main thread records
+// per status interval
+struct TrackingMetrics {
+    // Sampler thread
+    MetricCounter frames;
+    MetricHistogram frameTime;    // locate + filter + gestures + fan-out
+    MetricHistogram locateCall;   // each xrLocateHandJointsEXT call
+    struct Hand {
+        MetricCounter activeFrames;
+        MetricCounter positionInvalidJoints;     // in active frames
+        MetricCounter orientationInvalidJoints;  // in active frames
+        ResultCounters failures;
+    } hands[HAND_COUNT];
+
+    // Main thread, from each scheduler interval
+    MetricGauge achievedRateHz;
+    MetricGauge wakeJitterRmsUs;
+    MetricGauge wakeJitterMaxUs;
+    MetricCounter overruns;
+    MetricCounter skippedTicks;
+
+    // Main thread, from the session lifecycle
+    MetricGauge sessionState;     // XrSessionState, 0 while there is no session
+    MetricCounter sessionRecoveries;
+
+    // Sampler thread, only while gesture detection is on
+    MetricCounter gestureEvents;
+
+    // Sampler thread: everything per-frame for one located frame
+    void RecordFrame(const HandFrame& frame) {
+        frames.Add();
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            const HandFrame::Hand& data = frame.hands[hand];
+            Hand& metrics = hands[hand];
+            if (XR_FAILED(data.result)) {
+                metrics.failures.Add(data.result);
+                continue;
+            }
+            if (!data.isActive) {
+                continue;
+            }
+            metrics.activeFrames.Add();
+            uint64_t positionInvalid = 0;
+            uint64_t orientationInvalid = 0;
+            for (uint32_t j = 0; j < data.jointCount && j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+                const XrSpaceLocationFlags flags = data.joints[j].locationFlags;
+                positionInvalid += (flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) ? 0 : 1;
+                orientationInvalid += (flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) ? 0 : 1;
+            }
+            if (positionInvalid != 0) {
+                metrics.positionInvalidJoints.Add(positionInvalid);
+            }
+            if (orientationInvalid != 0) {
+                metrics.orientationInvalidJoints.Add(orientationInvalid);
+            }
+        }
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Prometheus text format
+// ----------------------------------------------------------------------------
+
+class PrometheusWriter {
+public:
+    explicit PrometheusWriter(std::string& out) : m_out(out) {}
+
+    // # HELP and # TYPE lines; call once per metric name
+    void Header(const char* name, const char* type, const char* help) {
+        m_out += "# HELP ";
+        m_out += name;
+        m_out += ' ';
+        m_out += help;
+        m_out += "\n# TYPE ";
+        m_out += name;
+        m_out += ' ';
+        m_out += type;
+        m_out += '\n';
+    }
+
+    // labels is either empty or e.g. "hand=\"left\""
+    void Sample(const char* name, const std::string& labels, double value) {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%.17g", value);
+        m_out += name;
+        if (!labels.empty()) {
+            m_out += '{';
+            m_out += labels;
+            m_out += '}';
+        }
+        m_out += ' ';
+        m_out += number;
+        m_out += '\n';
+    }
+
+    void Metric(const char* name, const char* type, const char* help, double value) {
+        Header(name, type, help);
+        Sample(name, "", value);
+    }
+
+    void Histogram(const char* name, const char* help, const MetricHistogram& histogram) {
+        Header(name, "histogram", help);
+        std::string bucketName = std::string(name) + "_bucket";
+        uint64_t cumulative = 0;
+        for (int bucket = 0; bucket < MetricHistogram::BUCKET_COUNT; ++bucket) {
+            cumulative += histogram.GetBucket(bucket);
+            char bound[32];
+            if (bucket < MetricHistogram::BUCKET_COUNT - 1) {
+                std::snprintf(bound, sizeof(bound), "le=\"%g\"", MetricHistogram::BUCKET_BOUNDS_NS[bucket] / 1e9);
+            } else {
+                std::snprintf(bound, sizeof(bound), "le=\"+Inf\"");
+            }
+            Sample(bucketName.c_str(), bound, static_cast<double>(cumulative));
+        }
+        Sample((std::string(name) + "_sum").c_str(), "", histogram.GetSumNs() / 1e9);
+        Sample((std::string(name) + "_count").c_str(), "", static_cast<double>(cumulative));
+    }
+
+private:
+    std::string& m_out;
+};
+
+inline std::string HandLabel(int hand) {
+    return hand == 0 ? "hand=\"left\"" : "hand=\"right\"";
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+// Default port of the metrics endpoint (--metrics <port>)
+constexpr uint16_t DEFAULT_METRICS_PORT = 9464;
+
+// Minimal HTTP/1.0 server for Prometheus scrapes. Answers GET /metrics
+// with whatever the writer renders and everything else with 404, one
+// connection at a time, on its own thread. It binds to loopback unless
+// another host is given; the counters are not meant for the network.
+class MetricsServer {
+public:
+    using Writer = std::function<void(std::string&)>;
+
+    ~MetricsServer() {
+        Stop();
+    }
+
+    // address is "[host:]port"; host defaults to 127.0.0.1
+    bool Start(const std::string& address, Writer writer) {
+        size_t colon = address.rfind(':');
+        std::string host = colon == std::string::npos ? "127.0.0.1" : address.substr(0, colon);
+        std::string port = colon == std::string::npos ? address : address.substr(colon + 1);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* addresses = nullptr;
+        int error = getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses);
+        if (error != 0) {
+            std::cerr << "Invalid metrics address " << address << ": " << gai_strerror(error) << std::endl;
+            return false;
+        }
+        m_socket = socket(addresses->ai_family, addresses->ai_socktype | SOCK_CLOEXEC, addresses->ai_protocol);
+        int reuse = 1;
+        bool listening = m_socket >= 0 &&
+                         setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) == 0 &&
+                         bind(m_socket, addresses->ai_addr, addresses->ai_addrlen) == 0 &&
+                         listen(m_socket, LISTEN_BACKLOG) == 0;
+        freeaddrinfo(addresses);
+        if (!listening) {
+            std::cerr << "Failed to listen for metrics on " << host << ":" << port << ": " << std::strerror(errno) << std::endl;
+            Close();
+            return false;
+        }
+
+        m_address = host + ":" + port;
+        m_writer = std::move(writer);
+        m_running.store(true);
+        m_thread = std::thread(&MetricsServer::Serve, this);
+        return true;
+    }
+
+    void Stop() {
+        m_running.store(false);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        Close();
+    }
+
+    bool IsRunning() const { return m_thread.joinable(); }
+    const std::string& GetAddress() const { return m_address; }
+    uint64_t GetScrapeCount() const { return m_scrapes.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int LISTEN_BACKLOG = 8;
+    static constexpr int POLL_PERIOD_MS = 100;     // how quickly Stop() is noticed
+    static constexpr int REQUEST_TIMEOUT_MS = 1000;
+    static constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+    int m_socket = -1;
+    std::string m_address;
+    Writer m_writer;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_scrapes{0};
+    std::string m_body;  // reused between scrapes
+
+    void Close() {
+        if (m_socket >= 0) {
+            ::close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    void Serve() {
+        while (m_running.load()) {
+            pollfd descriptor{m_socket, POLLIN, 0};
+            if (poll(&descriptor, 1, POLL_PERIOD_MS) <= 0) {
+                continue;
+            }
+            int client = accept4(m_socket, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0) {
+                continue;
+            }
+            HandleRequest(client);
+            ::close(client);
+        }
+    }
+
+    // Reads the request head (up to the blank line) and answers it
+    void HandleRequest(int client) {
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+            pollfd descriptor{client, POLLIN, 0};
+            if (poll(&descriptor, 1, REQUEST_TIMEOUT_MS) <= 0) {
+                return;
+            }
+            ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return;
+            }
+            request.append(buffer, static_cast<size_t>(received));
+        }
+
+        size_t lineEnd = request.find("\r\n");
+        std::string line = request.substr(0, lineEnd);
+        size_t pathStart = line.find(' ');
+        size_t pathEnd = pathStart == std::string::npos ? std::string::npos : line.find(' ', pathStart + 1);
+        std::string method = line.substr(0, pathStart);
+        std::string path = pathEnd == std::string::npos ? "" : line.substr(pathStart + 1, pathEnd - pathStart - 1);
+        path = path.substr(0, path.find('?'));
+
+        if (method != "GET" || path != "/metrics") {
+            Respond(client, "404 Not Found", "text/plain", "Not found - metrics are at /metrics\n");
+            return;
+        }
+        m_body.clear();
+        m_writer(m_body);
+        m_scrapes.fetch_add(1, std::memory_order_relaxed);
+        Respond(client, "200 OK", "text/plain; version=0.0.4; charset=utf-8", m_body);
+    }
+
+    static void Respond(int client, const char* status, const char* contentType, const std::string& body) {
+        std::string response = std::string("HTTP/1.0 ") + status + "\r\nContent-Type: " + contentType +
+                               "\r\nContent-Length: " + std::to_string(body.size()) +
+                               "\r\nConnection: close\r\n\r\n" + body;
+        size_t sent = 0;
+        while (sent < response.size()) {
+            ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+// Splits "host", "host:port", "[ipv6]" or "[ipv6]:port" into its host and
+// port; port is left unchanged if the address has none. An IPv6 literal
+// without brackets ("::1", "fe80::2") is all host, since its last colon
+// cannot be told apart from a port separator. Returns false for an empty
+// host or port, or an unclosed bracket.
+inline bool SplitHostPort(const std::string& address, std::string& host, std::string& port) {
+    if (!address.empty() && address[0] == '[') {
+        size_t close = address.find(']');
+        if (close == std::string::npos) {
+            return false;
+        }
+        host = address.substr(1, close - 1);
+        if (close + 1 < address.size()) {
+            if (address[close + 1] != ':') {
+                return false;
+            }
+            port = address.substr(close + 2);
+        }
+    } else {
+        size_t colon = address.rfind(':');
+        if (colon != std::string::npos && address.find(':') == colon) {
+            host = address.substr(0, colon);
+            port = address.substr(colon + 1);
+        } else {
+            host = address;
+        }
+    }
+    return !host.empty() && !port.empty();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+// Numeric option values must be a whole number of the right range or a
+// finite decimal; trailing text ("20hz"), empty values and overflow are
+// rejected instead of silently turning into 0 or a truncated value.
+inline bool ParseNumber(const char* text, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || errno != 0 || !std::isfinite(parsed)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+template <typename T>
+inline bool ParseInteger(const char* text, T& value) {
+    static_assert(std::is_integral<T>::value, "ParseInteger needs an integer type");
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0) {
+        return false;
+    }
+    if (parsed < 0 ? std::is_unsigned<T>::value || parsed < static_cast<long long>(std::numeric_limits<T>::min())
+                   : static_cast<unsigned long long>(parsed) > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+        return false;
+    }
+    value = static_cast<T>(parsed);
+    return true;
+}
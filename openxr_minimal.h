@@ -1,6 +1,10 @@
 #pragma once
 
+// XR_USE_TIMESPEC exposes XR_KHR_convert_timespec_time in openxr_platform.h
+#define XR_USE_TIMESPEC
+#include <time.h>
 #include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
 #include <string>
 
 // Just the minimal OpenXR types and constants we need for hand tracking
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "openxr_minimal.h"
+#include <cmath>
+
+// Small vector/quaternion helpers on the OpenXR math types
+
+inline XrVector3f Add(const XrVector3f& a, const XrVector3f& b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+inline XrVector3f Sub(const XrVector3f& a, const XrVector3f& b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+inline XrVector3f Scale(const XrVector3f& v, float s) {
+    return {v.x * s, v.y * s, v.z * s};
+}
+
+inline float Dot(const XrVector3f& a, const XrVector3f& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline XrVector3f Cross(const XrVector3f& a, const XrVector3f& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+inline float Length(const XrVector3f& v) {
+    return std::sqrt(Dot(v, v));
+}
+
+inline float Distance(const XrVector3f& a, const XrVector3f& b) {
+    return Length(Sub(a, b));
+}
+
+inline XrQuaternionf QuatIdentity() {
+    return {0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+inline XrQuaternionf QuatFromAxisAngle(const XrVector3f& axis, float angle) {
+    float s = std::sin(angle * 0.5f);
+    return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+inline XrQuaternionf QuatMultiply(const XrQuaternionf& a, const XrQuaternionf& b) {
+    return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+}
+
+inline XrQuaternionf QuatConjugate(const XrQuaternionf& q) {
+    return {-q.x, -q.y, -q.z, q.w};
+}
+
+inline float QuatDot(const XrQuaternionf& a, const XrQuaternionf& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+inline XrQuaternionf QuatNormalize(const XrQuaternionf& q) {
+    float length = std::sqrt(QuatDot(q, q));
+    if (length <= 0.0f) {
+        return QuatIdentity();
+    }
+    float inv = 1.0f / length;
+    return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+inline XrVector3f QuatRotate(const XrQuaternionf& q, const XrVector3f& v) {
+    // v' = v + 2w(u x v) + 2u x (u x v), u = q.xyz
+    XrVector3f u{q.x, q.y, q.z};
+    XrVector3f t = Scale(Cross(u, v), 2.0f);
+    return Add(Add(v, Scale(t, q.w)), Cross(u, t));
+}
+
+// Angle in radians between two orientations
+inline float QuatAngle(const XrQuaternionf& a, const XrQuaternionf& b) {
+    float d = std::fabs(QuatDot(a, b));
+    return 2.0f * std::acos(d > 1.0f ? 1.0f : d);
+}
+
+// Pose composition: apply local in the frame of parent
+inline XrPosef PoseMultiply(const XrPosef& parent, const XrPosef& local) {
+    XrPosef result;
+    result.orientation = QuatMultiply(parent.orientation, local.orientation);
+    result.position = Add(parent.position, QuatRotate(parent.orientation, local.position));
+    return result;
+}
+
+inline XrPosef PoseInverse(const XrPosef& pose) {
+    XrPosef result;
+    result.orientation = QuatConjugate(pose.orientation);
+    result.position = QuatRotate(result.orientation, Scale(pose.position, -1.0f));
+    return result;
+}
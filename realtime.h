@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// ============================================================================
+// Real-time mode
+// ============================================================================
+// Opt-in measures against preemption of the sampling loop on a loaded box:
+//
+//   - the process's memory is locked (mlockall), so no page of it can be
+//     swapped out or demand-faulted in the middle of a frame
+//   - the frame buffers and the sampler's stack are touched once before
+//     sampling, so their first use does not fault either
+//   - the sampler thread is pinned to one CPU and runs SCHED_FIFO, so
+//     ordinary threads cannot preempt it
+//
+// Every step is attempted on its own. One that fails (typically for lack of
+// CAP_SYS_NICE / an rtprio limit, or CAP_IPC_LOCK / a memlock limit) is
+// reported and skipped, and sampling goes on with whatever did succeed.
+//
+// ApplyRealtimeToCurrentThread() only records what happened; the caller
+// prints the outcome from another thread, so the sampler itself never
+// touches iostreams or the heap.
+// ============================================================================
+
+// Priority below the kernel's threaded interrupt handlers (50), which the
+// locate call may depend on (network, USB)
+constexpr int DEFAULT_REALTIME_PRIORITY = 40;
+
+// Touched ahead of sampling on the sampler's stack; far more than a frame
+// needs (the deepest frame, gesture detection, uses a few KiB)
+constexpr size_t REALTIME_STACK_PREFAULT_BYTES = 256 * 1024;
+
+struct RealtimeConfig {
+    bool enabled = false;
+    int cpu = -1;  // -1: the last CPU the process may run on
+    int priority = DEFAULT_REALTIME_PRIORITY;
+};
+
+// Rejects a priority outside SCHED_FIFO's range, a negative CPU and real-time
+// mode without a sample rate: free-running at SCHED_FIFO never sleeps, so
+// it would lock every other thread off the sampler's CPU
+inline bool ValidateRealtimeConfig(const RealtimeConfig& config, double sampleRateHz, std::ostream& err) {
+    if (config.priority < sched_get_priority_min(SCHED_FIFO) ||
+        config.priority > sched_get_priority_max(SCHED_FIFO) || config.cpu < -1) {
+        err << "Real-time priority must be between " << sched_get_priority_min(SCHED_FIFO) << " and "
+            << sched_get_priority_max(SCHED_FIFO) << ", and the CPU must not be negative" << std::endl;
+        return false;
+    }
+    if (config.enabled && sampleRateHz == 0.0) {
+        err << "--realtime needs a sample rate; it cannot be combined with --rate 0" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// What the setup achieved; 0 errors mean success
+struct RealtimeStatus {
+    int cpu = -1;
+    int priority = 0;
+    int affinityError = 0;
+    int schedulerError = 0;
+};
+
+// The last CPU in this process's affinity mask, or -1
+inline int LastAllowedCpu() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return -1;
+    }
+    for (int cpu = CPU_SETSIZE - 1; cpu >= 0; --cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+// Locks all current and future pages of the process. Returns 0 or errno.
+inline int LockProcessMemory() {
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 0 : errno;
+}
+
+inline void UnlockProcessMemory() {
+    munlockall();
+}
+
+// Reads one byte per page of a buffer to fault it in. The buffers it is
+// used on were written when they were allocated, so this only brings back
+// pages the kernel has since reclaimed. It only reads, so it never changes
+// data, but the reads are not synchronized with threads that write the
+// same buffer; call it before those threads start writing.
+inline void PrefaultPages(const void* data, size_t bytes) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const volatile unsigned char* bytesPtr = static_cast<const volatile unsigned char*>(data);
+    for (size_t offset = 0; offset < bytes; offset += page) {
+        (void)bytesPtr[offset];
+    }
+}
+
+// Grows the calling thread's stack by REALTIME_STACK_PREFAULT_BYTES once
+// so later frames find those pages present
+__attribute__((noinline)) inline void PrefaultStack() {
+    volatile unsigned char stack[REALTIME_STACK_PREFAULT_BYTES];
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t offset = 0; offset < sizeof(stack); offset += page) {
+        stack[offset] = 0;
+    }
+}
+
+// Pins the calling thread and makes it SCHED_FIFO; allocation-free
+inline RealtimeStatus ApplyRealtimeToCurrentThread(const RealtimeConfig& config) {
+    RealtimeStatus status;
+    status.cpu = config.cpu >= 0 ? config.cpu : LastAllowedCpu();
+    status.priority = config.priority;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (status.cpu < 0 || status.cpu >= CPU_SETSIZE) {
+        status.affinityError = EINVAL;
+    } else {
+        CPU_SET(status.cpu, &cpus);
+        status.affinityError = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    sched_param param{};
+    param.sched_priority = config.priority;
+    status.schedulerError = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+    PrefaultStack();
+    return status;
+}
+
+// The calling thread's CPU mask and scheduling policy. Taken before
+// ApplyRealtimeToCurrentThread(), which narrows the mask to one CPU, so
+// the thread can be put back before it is reused for something else
+// (e.g. in the benchmark).
+struct ThreadScheduling {
+    cpu_set_t cpus;
+    bool cpusSaved = false;
+    int policy = SCHED_OTHER;
+    sched_param param{};
+    bool policySaved = false;
+};
+
+inline ThreadScheduling SaveCurrentThreadScheduling() {
+    ThreadScheduling saved;
+    CPU_ZERO(&saved.cpus);
+    saved.cpusSaved = pthread_getaffinity_np(pthread_self(), sizeof(saved.cpus), &saved.cpus) == 0;
+    saved.policySaved = pthread_getschedparam(pthread_self(), &saved.policy, &saved.param) == 0;
+    return saved;
+}
+
+inline void RestoreCurrentThreadScheduling(const ThreadScheduling& saved) {
+    if (saved.policySaved) {
+        pthread_setschedparam(pthread_self(), saved.policy, &saved.param);
+    }
+    if (saved.cpusSaved) {
+        pthread_setaffinity_np(pthread_self(), sizeof(saved.cpus), &saved.cpus);
+    }
+}
+
+// One line per step, e.g. for the status output
+inline void PrintRealtimeStatus(std::ostream& out, const RealtimeStatus& status, int memoryLockError) {
+    out << "Real-time: CPU " << status.cpu << " pinning "
+        << (status.affinityError == 0 ? "ok" : std::strerror(status.affinityError))
+        << ", SCHED_FIFO " << status.priority << " "
+        << (status.schedulerError == 0 ? "ok" : std::strerror(status.schedulerError))
+        << ", memory lock " << (memoryLockError == 0 ? "ok" : std::strerror(memoryLockError)) << std::endl;
+    if (status.schedulerError == EPERM) {
+        out << "  SCHED_FIFO needs CAP_SYS_NICE or an rtprio limit (ulimit -r / limits.conf) - running with the normal scheduler" << std::endl;
+    }
+    if (memoryLockError == ENOMEM || memoryLockError == EPERM) {
+        out << "  mlockall needs CAP_IPC_LOCK or a larger memlock limit (ulimit -l) - memory stays pageable" << std::endl;
+    }
+}
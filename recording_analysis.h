@@ -0,0 +1,431 @@
+#pragma once
+
+#include "frame_recording.h"
+#include "hand_frame_soa.h"
+#include "latency_histogram.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Offline analysis of .htrec recordings
+// ============================================================================
+// Triage statistics for recorded sessions, computed from the mmap()ed
+// records without copying them:
+//
+//   - sampling: interval histogram, gaps (intervals over
+//     ANALYSIS_GAP_FACTOR target periods) and frames the recorder dropped
+//     (jumps in the frame index)
+//   - per hand: active frames, locate failures and dropouts (a run of
+//     inactive frames after an active one) with their durations
+//   - per joint: frames without a valid position / orientation while the
+//     hand is active, jitter (second difference of the position over three
+//     consecutive valid samples, which at high rates is almost all noise)
+//     and the length of the bone into the joint (mean, spread and linear
+//     drift over the session)
+//
+// A session is split into tasks of ANALYSIS_TASK_CHUNKS chunks. Worker
+// threads claim tasks from a shared counter, so a thread that finishes
+// early simply takes the next one, across sessions. Every statistic merges
+// exactly, so the result does not depend on how tasks were distributed
+// (beyond floating-point rounding): a task reads the two records before
+// it for intervals and jitter, and a dropout is measured by the task it
+// starts in, reading on past the end of the task if needed.
+// ============================================================================
+
+constexpr uint64_t ANALYSIS_TASK_CHUNKS = 8;  // ~14 MiB of records per task
+constexpr double ANALYSIS_GAP_FACTOR = 1.5;
+
+// Count, mean, variance, range and least-squares slope over time of one
+// quantity. Merged with the pairwise formulas of Chan et al., so partial
+// results from any split of the data combine without loss of precision.
+struct TrendStats {
+    uint64_t count = 0;
+    double meanT = 0.0;
+    double meanY = 0.0;
+    double m2T = 0.0;   // sum of squared deviations of t
+    double m2Y = 0.0;   // sum of squared deviations of y
+    double cTY = 0.0;   // sum of co-deviations
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    void Merge(const TrendStats& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const double n = static_cast<double>(count + other.count);
+        const double weight = static_cast<double>(count) * other.count / n;
+        const double dT = other.meanT - meanT;
+        const double dY = other.meanY - meanY;
+        meanT += dT * other.count / n;
+        meanY += dY * other.count / n;
+        m2T += other.m2T + dT * dT * weight;
+        m2Y += other.m2Y + dY * dY * weight;
+        cTY += other.cTY + dT * dY * weight;
+        count += other.count;
+        minY = std::min(minY, other.minY);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    double StdDev() const { return count > 1 ? std::sqrt(m2Y / (count - 1)) : 0.0; }
+    double Slope() const { return m2T > 0.0 ? cTY / m2T : 0.0; }
+};
+
+struct JointAnalysis {
+    uint64_t positionInvalid = 0;     // active frames without a valid position
+    uint64_t orientationInvalid = 0;  // active frames without a valid orientation
+    uint64_t jitterSamples = 0;
+    double jitterSumSq = 0.0;         // m^2
+    double jitterMaxSq = 0.0;         // m^2
+    TrendStats bone;                  // length of the bone into this joint (m) over time (s)
+
+    void Merge(const JointAnalysis& other) {
+        positionInvalid += other.positionInvalid;
+        orientationInvalid += other.orientationInvalid;
+        jitterSamples += other.jitterSamples;
+        jitterSumSq += other.jitterSumSq;
+        jitterMaxSq = std::max(jitterMaxSq, other.jitterMaxSq);
+        bone.Merge(other.bone);
+    }
+
+    double JitterRms() const { return jitterSamples ? std::sqrt(jitterSumSq / jitterSamples) : 0.0; }
+    double JitterMax() const { return std::sqrt(jitterMaxSq); }
+};
+
+struct HandAnalysis {
+    uint64_t activeFrames = 0;
+    uint64_t locateFailures = 0;
+    LatencyHistogram dropouts;  // duration of each dropout, ns
+    int64_t dropoutNs = 0;      // total time lost to dropouts
+    JointAnalysis joints[XR_HAND_JOINT_COUNT_EXT];
+
+    void Merge(const HandAnalysis& other) {
+        activeFrames += other.activeFrames;
+        locateFailures += other.locateFailures;
+        dropouts.Merge(other.dropouts);
+        dropoutNs += other.dropoutNs;
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            joints[j].Merge(other.joints[j]);
+        }
+    }
+};
+
+struct SessionAnalysis {
+    uint64_t frames = 0;
+    LatencyHistogram intervals;  // between consecutive samples, ns
+    uint64_t gaps = 0;           // intervals over ANALYSIS_GAP_FACTOR target periods
+    int64_t gapNs = 0;           // time missing in those gaps beyond one period
+    uint64_t recorderDrops = 0;  // frames missing from the frame index sequence
+    HandAnalysis hands[HAND_COUNT];
+
+    void Merge(const SessionAnalysis& other) {
+        frames += other.frames;
+        intervals.Merge(other.intervals);
+        gaps += other.gaps;
+        gapNs += other.gapNs;
+        recorderDrops += other.recorderDrops;
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            hands[hand].Merge(other.hands[hand]);
+        }
+    }
+};
+
+inline bool IsRecordedHandActive(const RecordedHand& hand) {
+    return hand.result >= 0 && hand.isActive;
+}
+
+// Target interval of a recording, 0 if it was free-running
+inline int64_t RecordingPeriodNs(const RecordingReader& reader) {
+    double rate = reader.Header()->sampleRateHz;
+    return rate > 0.0 ? static_cast<int64_t>(1e9 / rate) : 0;
+}
+
+// Per-joint state and accumulators of one hand over one task, one lane per
+// joint as in hand_frame_soa.h. Validity is 1.0f / 0.0f and every update is
+// a multiply by it instead of a branch, so the joint loops vectorize.
+// Sums are relative to the task's first sample time, which keeps them small
+// enough to turn into deviations without cancellation.
+struct alignas(32) HandAnalysisLanes {
+    // Current sample; positions of invalid joints are 0
+    float px[SOA_LANES], py[SOA_LANES], pz[SOA_LANES];
+    float positionValid[SOA_LANES];
+    float orientationValid[SOA_LANES];
+    float parentPx[SOA_LANES], parentPy[SOA_LANES], parentPz[SOA_LANES];
+    float boneValid[SOA_LANES];  // joint and parent valid, and the joint has a parent
+
+    // Previous sample and the step into it, for the second difference
+    float lastPx[SOA_LANES], lastPy[SOA_LANES], lastPz[SOA_LANES];
+    float lastValid[SOA_LANES];
+    float stepX[SOA_LANES], stepY[SOA_LANES], stepZ[SOA_LANES];
+    float stepValid[SOA_LANES];  // both samples valid and evenly spaced
+
+    float positionInvalid[SOA_LANES];
+    float orientationInvalid[SOA_LANES];
+    float jitterSamples[SOA_LANES];
+    float jitterMaxSq[SOA_LANES];
+    double jitterSumSq[SOA_LANES];
+    double boneCount[SOA_LANES], boneSumT[SOA_LANES], boneSumY[SOA_LANES];
+    double boneSumTT[SOA_LANES], boneSumYY[SOA_LANES], boneSumTY[SOA_LANES];
+    float boneMin[SOA_LANES], boneMax[SOA_LANES];
+
+    void Reset() {
+        std::memset(this, 0, sizeof(*this));
+        std::fill(boneMin, boneMin + SOA_LANES, std::numeric_limits<float>::max());
+        std::fill(boneMax, boneMax + SOA_LANES, std::numeric_limits<float>::lowest());
+    }
+
+    // Transposes a recorded hand into the current sample; an inactive hand
+    // has every joint invalid
+    void Load(const RecordedHand& hand) {
+        const bool active = IsRecordedHandActive(hand);
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const uint8_t flags = active ? hand.locationFlags[j] : 0;
+            const float valid = (flags & XR_SPACE_LOCATION_POSITION_VALID_BIT) ? 1.0f : 0.0f;
+            px[j] = valid != 0.0f ? hand.joints[j].position[0] : 0.0f;
+            py[j] = valid != 0.0f ? hand.joints[j].position[1] : 0.0f;
+            pz[j] = valid != 0.0f ? hand.joints[j].position[2] : 0.0f;
+            positionValid[j] = valid;
+            orientationValid[j] = (flags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) ? 1.0f : 0.0f;
+        }
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const int parent = JOINT_PARENT[j];
+            parentPx[j] = px[parent];
+            parentPy[j] = py[parent];
+            parentPz[j] = pz[parent];
+            boneValid[j] = parent != j ? positionValid[j] * positionValid[parent] : 0.0f;
+        }
+    }
+
+    // Adds the current sample. evenlySpaced: the interval from the previous
+    // sample is a regular one. weight 0 only advances the state (for the
+    // samples in front of a task).
+    void Accumulate(float active, float evenlySpaced, float weight, double t) {
+        const float invalidWeight = active * weight;
+        for (int j = 0; j < SOA_LANES; ++j) {
+            positionInvalid[j] += invalidWeight * (1.0f - positionValid[j]);
+            orientationInvalid[j] += invalidWeight * (1.0f - orientationValid[j]);
+
+            const float sx = px[j] - lastPx[j];
+            const float sy = py[j] - lastPy[j];
+            const float sz = pz[j] - lastPz[j];
+            const float dx = sx - stepX[j];
+            const float dy = sy - stepY[j];
+            const float dz = sz - stepZ[j];
+            const float newStepValid = positionValid[j] * lastValid[j] * evenlySpaced;
+            const float jitterWeight = newStepValid * stepValid[j] * weight;
+            const float squared = (dx * dx + dy * dy + dz * dz) * jitterWeight;
+            jitterSamples[j] += jitterWeight;
+            jitterSumSq[j] += squared;
+            jitterMaxSq[j] = std::max(jitterMaxSq[j], squared);
+            stepX[j] = sx;
+            stepY[j] = sy;
+            stepZ[j] = sz;
+            stepValid[j] = newStepValid;
+            lastPx[j] = px[j];
+            lastPy[j] = py[j];
+            lastPz[j] = pz[j];
+            lastValid[j] = positionValid[j];
+        }
+
+        // Square roots on their own: with errno semantics they keep the
+        // loop they are in from vectorizing
+        float lengths[SOA_LANES];
+        for (int j = 0; j < SOA_LANES; ++j) {
+            const float bx = px[j] - parentPx[j];
+            const float by = py[j] - parentPy[j];
+            const float bz = pz[j] - parentPz[j];
+            lengths[j] = bx * bx + by * by + bz * bz;
+        }
+        for (int j = 0; j < SOA_LANES; ++j) {
+            lengths[j] = std::sqrt(lengths[j]);
+        }
+        for (int j = 0; j < SOA_LANES; ++j) {
+            const float w = boneValid[j] * weight;
+            const double y = lengths[j];
+            boneCount[j] += w;
+            boneSumT[j] += w * t;
+            boneSumY[j] += w * y;
+            boneSumTT[j] += w * t * t;
+            boneSumYY[j] += w * y * y;
+            boneSumTY[j] += w * t * y;
+            boneMin[j] = std::min(boneMin[j], w > 0.0f ? lengths[j] : std::numeric_limits<float>::max());
+            boneMax[j] = std::max(boneMax[j], w > 0.0f ? lengths[j] : std::numeric_limits<float>::lowest());
+        }
+    }
+
+    // Adds the task's totals to a hand's result; originT is the task's
+    // first sample time in seconds since the start of the recording
+    void MergeInto(HandAnalysis& hand, double originT) const {
+        for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            JointAnalysis& joint = hand.joints[j];
+            joint.positionInvalid += static_cast<uint64_t>(positionInvalid[j]);
+            joint.orientationInvalid += static_cast<uint64_t>(orientationInvalid[j]);
+            joint.jitterSamples += static_cast<uint64_t>(jitterSamples[j]);
+            joint.jitterSumSq += jitterSumSq[j];
+            joint.jitterMaxSq = std::max<double>(joint.jitterMaxSq, jitterMaxSq[j]);
+
+            if (boneCount[j] > 0.0) {
+                const double n = boneCount[j];
+                TrendStats bone;
+                bone.count = static_cast<uint64_t>(n);
+                bone.meanT = originT + boneSumT[j] / n;
+                bone.meanY = boneSumY[j] / n;
+                bone.m2T = std::max(0.0, boneSumTT[j] - boneSumT[j] * boneSumT[j] / n);
+                bone.m2Y = std::max(0.0, boneSumYY[j] - boneSumY[j] * boneSumY[j] / n);
+                bone.cTY = boneSumTY[j] - boneSumT[j] * boneSumY[j] / n;
+                bone.minY = boneMin[j];
+                bone.maxY = boneMax[j];
+                joint.bone.Merge(bone);
+            }
+        }
+    }
+};
+
+// Accumulates frames [first, end) of a recording into result, using
+// lanes[HAND_COUNT] as scratch
+inline void AnalyzeFrames(const RecordingReader& reader, uint64_t first, uint64_t end, SessionAnalysis& result,
+                          HandAnalysisLanes* lanes) {
+    const int64_t periodNs = RecordingPeriodNs(reader);
+    const int64_t gapThresholdNs = static_cast<int64_t>(periodNs * ANALYSIS_GAP_FACTOR);
+    const uint64_t frameCount = reader.FrameCount();
+    if (first >= end) {
+        return;
+    }
+    const int64_t originNs = reader.Frame(first)->sampleTimeNs;
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        lanes[hand].Reset();
+    }
+
+    // The two records before the task only feed the jitter state
+    const RecordedFrame* previous = nullptr;
+    for (uint64_t position = first >= 2 ? first - 2 : 0; position < end; ++position) {
+        const RecordedFrame* frame = reader.Frame(position);
+        const bool counted = position >= first;
+
+        bool evenlySpaced = false;
+        if (previous != nullptr) {
+            int64_t interval = frame->sampleTimeNs - previous->sampleTimeNs;
+            evenlySpaced = frame->frameIndex == previous->frameIndex + 1 &&
+                           (periodNs == 0 || interval <= gapThresholdNs);
+            if (counted) {
+                result.intervals.Record(static_cast<uint64_t>(std::max<int64_t>(interval, 0)));
+                if (periodNs > 0 && interval > gapThresholdNs) {
+                    result.gaps++;
+                    result.gapNs += interval - periodNs;
+                }
+                if (frame->frameIndex > previous->frameIndex + 1) {
+                    result.recorderDrops += frame->frameIndex - previous->frameIndex - 1;
+                }
+            }
+        }
+        const double t = (frame->sampleTimeNs - originNs) * 1e-9;
+
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            const RecordedHand& data = frame->hands[hand];
+            const bool active = IsRecordedHandActive(data);
+            lanes[hand].Load(data);
+            lanes[hand].Accumulate(active ? 1.0f : 0.0f, evenlySpaced ? 1.0f : 0.0f, counted ? 1.0f : 0.0f, t);
+            if (!counted) {
+                continue;
+            }
+
+            HandAnalysis& out = result.hands[hand];
+            out.activeFrames += active ? 1 : 0;
+            out.locateFailures += data.result < 0 ? 1 : 0;
+
+            // A dropout belongs to the task holding its first inactive frame
+            if (!active && previous != nullptr && IsRecordedHandActive(previous->hands[hand])) {
+                uint64_t back = position + 1;
+                while (back < frameCount && !IsRecordedHandActive(reader.Frame(back)->hands[hand])) {
+                    back++;
+                }
+                // Until the hand is back, or the end of the recording
+                int64_t until = back < frameCount ? reader.Frame(back)->sampleTimeNs
+                                                  : reader.Frame(frameCount - 1)->sampleTimeNs;
+                int64_t duration = std::max<int64_t>(until - frame->sampleTimeNs, 0);
+                out.dropouts.Record(static_cast<uint64_t>(duration));
+                out.dropoutNs += duration;
+            }
+        }
+        if (counted) {
+            result.frames++;
+        }
+        previous = frame;
+    }
+
+    const double originT = (originNs - reader.Header()->startTimeNs) * 1e-9;
+    for (int hand = 0; hand < HAND_COUNT; ++hand) {
+        lanes[hand].MergeInto(result.hands[hand], originT);
+    }
+}
+
+// Analyzes every recording on `threads` worker threads (0 = one per CPU).
+// results[i] belongs to readers[i].
+inline void AnalyzeRecordings(const std::vector<const RecordingReader*>& readers, unsigned threads,
+                              std::vector<SessionAnalysis>& results) {
+    struct Task {
+        size_t session;
+        uint64_t firstFrame;
+        uint64_t endFrame;
+    };
+    std::vector<Task> tasks;
+    for (size_t session = 0; session < readers.size(); ++session) {
+        const uint64_t frames = readers[session]->FrameCount();
+        const uint64_t step = ANALYSIS_TASK_CHUNKS * RECORDING_CHUNK_FRAMES;
+        for (uint64_t first = 0; first < frames; first += step) {
+            tasks.push_back({session, first, std::min(frames, first + step)});
+        }
+    }
+
+    results.assign(readers.size(), SessionAnalysis());
+    std::vector<std::mutex> resultLocks(readers.size());
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(tasks.size(), 1)));
+
+    // Tasks are claimed in order, so a worker usually stays on one session
+    // and folds its partial result in once when it moves on
+    std::atomic<size_t> nextTask{0};
+    auto work = [&]() {
+        std::unique_ptr<SessionAnalysis> partial(new SessionAnalysis());
+        std::unique_ptr<HandAnalysisLanes[]> lanes(new HandAnalysisLanes[HAND_COUNT]);
+        size_t session = SIZE_MAX;
+        auto flush = [&]() {
+            if (session != SIZE_MAX) {
+                std::lock_guard<std::mutex> lock(resultLocks[session]);
+                results[session].Merge(*partial);
+                *partial = SessionAnalysis();
+            }
+        };
+        for (size_t index = nextTask.fetch_add(1); index < tasks.size(); index = nextTask.fetch_add(1)) {
+            const Task& task = tasks[index];
+            if (task.session != session) {
+                flush();
+                session = task.session;
+            }
+            AnalyzeFrames(*readers[task.session], task.firstFrame, task.endFrame, *partial, lanes.get());
+        }
+        flush();
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
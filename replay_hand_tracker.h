@@ -0,0 +1,114 @@
+#pragma once
+
+#include "standin_hand_tracker.h"
+#include "frame_recording.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Serves the frames of a .htrec recording (see frame_recording.h) through
+// the hand tracking entry points.
+//
+// With original timing, each locate call returns the frame that was
+// sampled at the same offset from the start of the recording as the
+// requested time (locateInfo->time, or "now" if it is 0) is from the
+// first locate call. In fast mode every locate call for a hand
+// returns that hand's next recorded frame, so the sampler rate alone
+// determines the replay speed (use --rate 0 for as fast as possible).
+class ReplayHandTracker : public StandInHandTracker {
+public:
+    bool Open(const std::string& path, bool fast, bool loop) {
+        if (!m_reader.Open(path)) {
+            return false;
+        }
+        if (m_reader.FrameCount() == 0) {
+            std::cerr << "Recording " << path << " contains no frames" << std::endl;
+            return false;
+        }
+        m_fast = fast;
+        m_loop = loop;
+        return true;
+    }
+
+    const char* Name() const override { return "replay"; }
+
+    bool IsFinished() const override { return m_finished.load(std::memory_order_relaxed); }
+
+    uint64_t FrameCount() const { return m_reader.FrameCount(); }
+    double RecordedRate() const { return m_reader.Header()->sampleRateHz; }
+    double DurationSeconds() const {
+        return (m_reader.Frame(m_reader.FrameCount() - 1)->sampleTimeNs - m_reader.Frame(0)->sampleTimeNs) / 1e9;
+    }
+
+    XrResult Locate(XrHandEXT hand, const XrHandJointsLocateInfoEXT* locateInfo,
+                    XrHandJointLocationsEXT* locations) override {
+        int handIndex = (hand == XR_HAND_LEFT_EXT) ? 0 : 1;
+        uint64_t position = m_fast ? NextPosition(handIndex) : TimedPosition(RequestedTimeNs(locateInfo));
+        const RecordedHand& recorded = m_reader.Frame(position)->hands[handIndex];
+
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; ++j) {
+            const RecordedJoint& in = recorded.joints[j];
+            XrHandJointLocationEXT& joint = locations->jointLocations[j];
+            joint.locationFlags = recorded.locationFlags[j];
+            joint.pose.position = {in.position[0], in.position[1], in.position[2]};
+            joint.pose.orientation = {in.orientation[0], in.orientation[1], in.orientation[2], in.orientation[3]};
+            joint.radius = in.radius;
+        }
+        locations->isActive = recorded.isActive;
+        return static_cast<XrResult>(recorded.result);
+    }
+
+private:
+    RecordingReader m_reader;
+    bool m_fast = false;
+    bool m_loop = false;
+    // Set by the sampler thread, polled by Run()
+    std::atomic<bool> m_finished{false};
+
+    uint64_t m_cursor[2] = {0, 0};
+
+    bool m_clockStarted = false;
+    int64_t m_replayStartNs = 0;
+
+    // The stand-in's XrTime is CLOCK_MONOTONIC in nanoseconds
+    static int64_t RequestedTimeNs(const XrHandJointsLocateInfoEXT* locateInfo) {
+        if (locateInfo != nullptr && locateInfo->time > 0) {
+            return locateInfo->time;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t NextPosition(int handIndex) {
+        uint64_t position = m_cursor[handIndex];
+        if (position + 1 < m_reader.FrameCount()) {
+            m_cursor[handIndex] = position + 1;
+        } else if (m_loop) {
+            m_cursor[handIndex] = 0;
+        } else {
+            m_finished.store(true, std::memory_order_relaxed);
+        }
+        return position;
+    }
+
+    uint64_t TimedPosition(int64_t nowNs) {
+        if (!m_clockStarted) {
+            m_clockStarted = true;
+            m_replayStartNs = nowNs;
+        }
+
+        int64_t firstNs = m_reader.Frame(0)->sampleTimeNs;
+        int64_t spanNs = m_reader.Frame(m_reader.FrameCount() - 1)->sampleTimeNs - firstNs;
+        int64_t elapsedNs = std::max<int64_t>(0, nowNs - m_replayStartNs);
+
+        if (elapsedNs > spanNs) {
+            if (m_loop && spanNs > 0) {
+                elapsedNs %= spanNs;
+            } else {
+                m_finished.store(true, std::memory_order_relaxed);
+                return m_reader.FrameCount() - 1;
+            }
+        }
+        return m_reader.FindFrameAtTime(firstNs + elapsedNs);
+    }
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// Drift-free periodic scheduler for the sampling loop.
+//
+// Ticks are placed on an absolute grid (start + n * period) rather than
+// "sleep for period after the work", so time spent locating joints or
+// writing output does not accumulate into the rate. The thread sleeps with
+// sleep_until() up to a short spin tail before each deadline and then
+// busy-waits the remainder, which keeps wake-up jitter well below the OS
+// timer slack at high rates.
+//
+// A target rate of 0 (or less) means "free-running": WaitForNextTick()
+// returns immediately and only the achieved rate is tracked.
+class SamplingScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t ticks = 0;         // ticks delivered in the interval
+        uint64_t overruns = 0;      // ticks whose deadline had already passed on arrival
+        uint64_t skippedTicks = 0;  // whole periods dropped to get back on the grid
+        double elapsedSeconds = 0.0;
+        double jitterMeanUs = 0.0;  // mean |wake - deadline|
+        double jitterRmsUs = 0.0;
+        double jitterMaxUs = 0.0;
+
+        double AchievedRate() const {
+            return elapsedSeconds > 0.0 ? ticks / elapsedSeconds : 0.0;
+        }
+    };
+
+    explicit SamplingScheduler(double targetRateHz,
+                               std::chrono::microseconds spinTail = std::chrono::microseconds(200))
+        : m_spinTail(spinTail) {
+        SetTargetRate(targetRateHz);
+    }
+
+    // Changes the rate at runtime. The grid is re-anchored on the next tick.
+    void SetTargetRate(double targetRateHz) {
+        m_targetRateHz = targetRateHz;
+        if (targetRateHz > 0.0) {
+            m_period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / targetRateHz));
+            if (m_period <= Clock::duration::zero()) {
+                m_period = Clock::duration(1);
+            }
+        } else {
+            m_period = Clock::duration::zero();
+        }
+        m_started = false;
+    }
+
+    double GetTargetRate() const { return m_targetRateHz; }
+
+    void SetSpinTail(std::chrono::microseconds spinTail) { m_spinTail = spinTail; }
+
+    // Blocks until the next deadline on the grid. Returns the number of
+    // ticks skipped because the previous iteration overran by more than a
+    // whole period.
+    uint64_t WaitForNextTick() {
+        auto now = Clock::now();
+
+        if (!m_started) {
+            m_started = true;
+            m_nextDeadline = now;
+            if (m_intervalStart == Clock::time_point{}) {
+                m_intervalStart = now;
+            }
+            RecordTick(Clock::duration::zero());
+            Advance();
+            return 0;
+        }
+
+        if (m_period == Clock::duration::zero()) {
+            RecordTick(Clock::duration::zero());
+            return 0;
+        }
+
+        uint64_t skipped = 0;
+        if (now > m_nextDeadline) {
+            // Deadline already missed: run this tick late, and drop any
+            // further ticks that fell entirely inside the overrun so we
+            // return to the original grid instead of bursting to catch up.
+            m_interval.overruns++;
+            skipped = static_cast<uint64_t>((now - m_nextDeadline) / m_period);
+            m_nextDeadline += m_period * static_cast<Clock::rep>(skipped);
+            m_interval.skippedTicks += skipped;
+        } else {
+            auto sleepTarget = m_nextDeadline - m_spinTail;
+            if (sleepTarget > now) {
+                std::this_thread::sleep_until(sleepTarget);
+            }
+            while ((now = Clock::now()) < m_nextDeadline) {
+                // spin tail
+            }
+        }
+
+        RecordTick(now - m_nextDeadline);
+        Advance();
+        return skipped;
+    }
+
+    // Returns statistics accumulated since the previous call and starts a
+    // new interval.
+    Stats TakeIntervalStats() {
+        auto now = Clock::now();
+        Stats stats = m_interval;
+        stats.elapsedSeconds = std::chrono::duration<double>(now - m_intervalStart).count();
+        if (stats.ticks > 0) {
+            stats.jitterMeanUs = m_jitterSumUs / stats.ticks;
+            stats.jitterRmsUs = std::sqrt(m_jitterSumSqUs / stats.ticks);
+        }
+        m_totalTicks += m_interval.ticks;
+        m_totalOverruns += m_interval.overruns;
+        m_totalSkipped += m_interval.skippedTicks;
+
+        m_interval = Stats{};
+        m_jitterSumUs = 0.0;
+        m_jitterSumSqUs = 0.0;
+        m_intervalStart = now;
+        return stats;
+    }
+
+    // How late the last tick woke up after its deadline
+    Clock::duration GetLastLateness() const { return m_lastLateness; }
+
+    uint64_t GetTotalTicks() const { return m_totalTicks + m_interval.ticks; }
+    uint64_t GetTotalOverruns() const { return m_totalOverruns + m_interval.overruns; }
+    uint64_t GetTotalSkippedTicks() const { return m_totalSkipped + m_interval.skippedTicks; }
+
+private:
+    double m_targetRateHz = 0.0;
+    Clock::duration m_period{};
+    std::chrono::microseconds m_spinTail;
+
+    bool m_started = false;
+    Clock::time_point m_nextDeadline{};
+    Clock::time_point m_intervalStart{};
+
+    Stats m_interval;
+    Clock::duration m_lastLateness{};
+    double m_jitterSumUs = 0.0;
+    double m_jitterSumSqUs = 0.0;
+
+    uint64_t m_totalTicks = 0;
+    uint64_t m_totalOverruns = 0;
+    uint64_t m_totalSkipped = 0;
+
+    void Advance() {
+        if (m_period != Clock::duration::zero()) {
+            m_nextDeadline += m_period;
+        }
+    }
+
+    void RecordTick(Clock::duration lateness) {
+        m_lastLateness = lateness;
+        double jitterUs = std::abs(std::chrono::duration<double, std::micro>(lateness).count());
+        m_interval.ticks++;
+        m_jitterSumUs += jitterUs;
+        m_jitterSumSqUs += jitterUs * jitterUs;
+        m_interval.jitterMaxUs = std::max(m_interval.jitterMaxUs, jitterUs);
+    }
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "hand_frame.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// Shared-memory frame layout (POSIX shm, one publisher, any number of readers)
+// ============================================================================
+//
+//   [SharedFrameHeader]
+//   [SharedFrameSlot latest]
+//   [SharedFrameSlot history[historyCapacity]]
+//
+// Every slot is protected by its own sequence counter (seqlock): the
+// publisher makes it odd, copies the frame, then makes it even again. A
+// reader copies the frame between two loads of the counter and retries if
+// the counter was odd or changed, so snapshots are never torn and reading
+// needs no syscalls or locks. The publisher never waits for readers.
+//
+// Frames are numbered by publish order (0, 1, 2, ... per publisher), which
+// is independent of HandFrame::frameIndex: the sampler's frame index keeps
+// counting across a stop/start of the app while a new publisher starts
+// again at 0. Publish number n lives in history slot
+// (n % historyCapacity), and the slot records n so readers can tell it
+// from an older or newer frame in the same slot.
+// ============================================================================
+
+constexpr char SHARED_FRAME_MAGIC[8] = {'H', 'T', 'S', 'H', 'M', '0', '1', '\0'};
+constexpr uint32_t SHARED_FRAME_VERSION = 4;
+constexpr uint32_t SHARED_FRAME_HISTORY = 64;
+constexpr const char* DEFAULT_SHARED_FRAME_NAME = "/handtracking";
+
+struct alignas(64) SharedFrameSlot {
+    std::atomic<uint64_t> sequence;
+    uint64_t publishIndex;  // publish number of the frame in the slot
+    HandFrame frame;
+};
+
+struct alignas(64) SharedFrameHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t frameSize;        // sizeof(HandFrame) of the publisher
+    uint32_t historyCapacity;
+    uint32_t publisherPid;
+    double sampleRateHz;
+    std::atomic<uint64_t> publishedCount;   // frames published so far
+    std::atomic<int64_t> lastPublishTimeNs; // steady_clock (CLOCK_MONOTONIC) of the last publish
+    std::atomic<uint32_t> publisherActive;  // cleared when the publisher shuts down cleanly
+};
+
+struct SharedFrameRegion {
+    SharedFrameHeader header;
+    SharedFrameSlot latest;
+    SharedFrameSlot history[SHARED_FRAME_HISTORY];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared seqlocks need lock-free 64-bit atomics");
+static_assert(std::is_trivially_copyable<HandFrame>::value, "HandFrame must be copyable into shared memory");
+
+// Seqlock write side (single writer)
+inline void SeqlockWrite(SharedFrameSlot& slot, const HandFrame& frame, uint64_t publishIndex) {
+    uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.publishIndex = publishIndex;
+    std::memcpy(&slot.frame, &frame, sizeof(HandFrame));
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Seqlock read side. Returns false if the slot was being written during
+// the copy (caller retries) or has never been written. publishIndex, if
+// given, receives the slot's publish number from the same snapshot.
+inline bool SeqlockTryRead(const SharedFrameSlot& slot, HandFrame& out, uint64_t* publishIndex = nullptr) {
+    uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before == 0 || (before & 1) != 0) {
+        return false;
+    }
+    uint64_t index = slot.publishIndex;
+    std::memcpy(&out, &slot.frame, sizeof(HandFrame));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+    if (publishIndex != nullptr) {
+        *publishIndex = index;
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "shared_frame_layout.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Publishes every sampled frame into a POSIX shared-memory region (see
+// shared_frame_layout.h). Publish() is two seqlock writes plus a few
+// atomic stores: no syscalls, no allocation and no waiting on readers, so
+// it runs directly on the sampler thread.
+class ShmPublisher {
+public:
+    ~ShmPublisher() {
+        Close();
+    }
+
+    // Creates the region, or takes over one left behind by a publisher
+    // that did not shut down cleanly. A region whose publisher is still
+    // running (it holds an flock on the segment for its whole lifetime),
+    // or one that is not a frame region at all, is left alone.
+    bool Open(const std::string& name, double sampleRateHz) {
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST) {
+            fd = shm_open(name.c_str(), O_RDWR, 0644);
+        }
+        if (fd < 0) {
+            std::cerr << "Failed to create shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            if (errno == EWOULDBLOCK) {
+                std::cerr << "Shared memory " << name << " is in use by another running publisher" << std::endl;
+            } else {
+                std::cerr << "Failed to lock shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            }
+            ::close(fd);
+            return false;
+        }
+        if (!IsReusable(fd)) {
+            std::cerr << "Shared memory " << name << " exists and is not a hand tracking frame region (remove /dev/shm"
+                      << name << " to reuse the name)" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        if (ftruncate(fd, sizeof(SharedFrameRegion)) != 0) {
+            std::cerr << "Failed to size shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        void* mapping = mmap(nullptr, sizeof(SharedFrameRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Failed to map shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+        m_fd = fd;
+
+        // Touch every page now so the first publishes do not fault, then
+        // write the header last so readers only attach to a complete region
+        std::memset(mapping, 0, sizeof(SharedFrameRegion));
+        m_region = new (mapping) SharedFrameRegion;
+        m_name = name;
+
+        SharedFrameHeader& header = m_region->header;
+        header.version = SHARED_FRAME_VERSION;
+        header.frameSize = sizeof(HandFrame);
+        header.historyCapacity = SHARED_FRAME_HISTORY;
+        header.publisherPid = static_cast<uint32_t>(getpid());
+        header.sampleRateHz = sampleRateHz;
+        header.publishedCount.store(0, std::memory_order_relaxed);
+        header.lastPublishTimeNs.store(0, std::memory_order_relaxed);
+        header.publisherActive.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(header.magic, SHARED_FRAME_MAGIC, sizeof(header.magic));
+        return true;
+    }
+
+    bool IsOpen() const { return m_region != nullptr; }
+    const std::string& GetName() const { return m_name; }
+    uint64_t GetPublishedCount() const {
+        return m_region ? m_region->header.publishedCount.load(std::memory_order_relaxed) : 0;
+    }
+
+    void Publish(const HandFrame& frame) {
+        SharedFrameHeader& header = m_region->header;
+        uint64_t count = header.publishedCount.load(std::memory_order_relaxed);
+
+        SeqlockWrite(m_region->history[count % SHARED_FRAME_HISTORY], frame, count);
+        SeqlockWrite(m_region->latest, frame, count);
+
+        header.lastPublishTimeNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        header.publishedCount.store(count + 1, std::memory_order_release);
+    }
+
+    // Marks the region inactive and removes the name; attached readers keep
+    // their mapping until they detach
+    void Close() {
+        if (m_region == nullptr) {
+            return;
+        }
+        m_region->header.publisherActive.store(0, std::memory_order_release);
+        munmap(m_region, sizeof(SharedFrameRegion));
+        shm_unlink(m_name.c_str());
+        ::close(m_fd);  // releases the lock
+        m_fd = -1;
+        m_region = nullptr;
+    }
+
+private:
+    SharedFrameRegion* m_region = nullptr;
+    int m_fd = -1;  // kept open to hold the publisher lock
+    std::string m_name;
+
+    // An empty segment (just created, or its creator died before sizing
+    // it) or one that starts with the frame region magic
+    static bool IsReusable(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            return false;
+        }
+        if (info.st_size == 0) {
+            return true;
+        }
+        char magic[sizeof(SHARED_FRAME_MAGIC)];
+        return pread(fd, magic, sizeof(magic), 0) == static_cast<ssize_t>(sizeof(magic)) &&
+               std::memcmp(magic, SHARED_FRAME_MAGIC, sizeof(magic)) == 0;
+    }
+};
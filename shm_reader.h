@@ -0,0 +1,118 @@
+#pragma once
+
+#include "shared_frame_layout.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Read-only client for the frames published by the tracking app with
+// --shm. Attach once, then poll at any rate: every read is a copy straight
+// from the shared mapping into the caller's frame, validated by the slot's
+// seqlock, with no syscalls and no effect on the publisher.
+//
+//   ShmReader reader;
+//   if (reader.Attach("/handtracking")) {
+//       HandFrame frame;
+//       if (reader.ReadLatest(frame)) { ... }
+//   }
+class ShmReader {
+public:
+    ~ShmReader() {
+        Detach();
+    }
+
+    bool Attach(const std::string& name = DEFAULT_SHARED_FRAME_NAME) {
+        Detach();
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            std::cerr << "Failed to open shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        // A region still being created, or a foreign segment, may be shorter
+        // than the layout; touching past its end would raise SIGBUS
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SharedFrameRegion))) {
+            std::cerr << "Shared memory " << name << " has an incompatible layout" << std::endl;
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, sizeof(SharedFrameRegion), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Failed to map shared memory " << name << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        m_region = static_cast<const SharedFrameRegion*>(mapping);
+
+        const SharedFrameHeader& header = m_region->header;
+        if (std::memcmp(header.magic, SHARED_FRAME_MAGIC, sizeof(SHARED_FRAME_MAGIC)) != 0 ||
+            header.version != SHARED_FRAME_VERSION ||
+            header.frameSize != sizeof(HandFrame) ||
+            header.historyCapacity != SHARED_FRAME_HISTORY) {
+            std::cerr << "Shared memory " << name << " has an incompatible layout" << std::endl;
+            Detach();
+            return false;
+        }
+        return true;
+    }
+
+    void Detach() {
+        if (m_region != nullptr) {
+            munmap(const_cast<SharedFrameRegion*>(m_region), sizeof(SharedFrameRegion));
+            m_region = nullptr;
+        }
+    }
+
+    bool IsAttached() const { return m_region != nullptr; }
+
+    // Number of frames published so far; cheap enough to poll for news
+    uint64_t PublishedCount() const {
+        return m_region->header.publishedCount.load(std::memory_order_acquire);
+    }
+
+    bool IsPublisherActive() const {
+        return m_region->header.publisherActive.load(std::memory_order_acquire) != 0;
+    }
+
+    // CLOCK_MONOTONIC nanoseconds of the last publish
+    int64_t LastPublishTimeNs() const {
+        return m_region->header.lastPublishTimeNs.load(std::memory_order_relaxed);
+    }
+
+    double SampleRateHz() const { return m_region->header.sampleRateHz; }
+
+    // Copies the most recent frame. Returns false if nothing was published
+    // yet or the publisher kept overwriting the slot for maxRetries reads.
+    bool ReadLatest(HandFrame& out, int maxRetries = 64) const {
+        for (int attempt = 0; attempt < maxRetries; ++attempt) {
+            if (SeqlockTryRead(m_region->latest, out)) {
+                return true;
+            }
+            if (PublishedCount() == 0) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // Copies the frame with publish number publishIndex (0 for the first
+    // frame of this publisher, up to PublishedCount() - 1) from the history
+    // ring. Returns false if it is not published yet or has already been
+    // overwritten.
+    bool ReadHistory(uint64_t publishIndex, HandFrame& out) const {
+        if (publishIndex >= PublishedCount()) {
+            return false;
+        }
+        const SharedFrameSlot& slot = m_region->history[publishIndex % SHARED_FRAME_HISTORY];
+        uint64_t slotIndex = 0;
+        return SeqlockTryRead(slot, out, &slotIndex) && slotIndex == publishIndex;
+    }
+
+private:
+    const SharedFrameRegion* m_region = nullptr;
+};
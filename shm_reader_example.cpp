@@ -0,0 +1,121 @@
+#include "shm_reader.h"
+#include "sampling_scheduler.h"
+#include "number_parsing.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <csignal>
+#include <atomic>
+
+// ============================================================================
+// Shared-memory reader example
+// ============================================================================
+// Attaches to the frames published by test_handtracking_only --shm <name>
+// and prints both palms at its own rate, together with the capture-to-read
+// latency (sample time to this read, both CLOCK_MONOTONIC) and how many
+// frames were missed between two reads. Any number of these
+// can run next to the tracking app without slowing it down.
+// ============================================================================
+
+static std::atomic<bool> g_stopRequested{false};
+
+static void HandleStopSignal(int) {
+    g_stopRequested.store(true);
+}
+
+static int64_t MonotonicNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --shm <name>        Shared memory to attach to (default " << DEFAULT_SHARED_FRAME_NAME << ")" << std::endl;
+    std::cout << "  --rate <hz>         Read rate (default 10)" << std::endl;
+    std::cout << "  --history           Also walk the history ring and report frames missed between reads" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string name = DEFAULT_SHARED_FRAME_NAME;
+    double rateHz = 10.0;
+    bool walkHistory = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--shm" && hasValue) {
+            name = argv[++i];
+            if (name.empty() || name[0] != '/') {
+                name = "/" + name;
+            }
+        } else if (arg == "--rate" && hasValue) {
+            if (!ParseNumber(argv[++i], rateHz) || rateHz <= 0.0) {
+                std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--history") {
+            walkHistory = true;
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    ShmReader reader;
+    if (!reader.Attach(name)) {
+        return -1;
+    }
+    std::cout << "Attached to " << name << " (publisher rate " << reader.SampleRateHz() << " Hz)" << std::endl;
+
+    SamplingScheduler scheduler(rateHz);
+    HandFrame frame;
+    uint64_t nextHistoryFrame = reader.PublishedCount();  // publish number, not frameIndex
+    uint64_t missed = 0;
+
+    while (!g_stopRequested.load()) {
+        scheduler.WaitForNextTick();
+
+        if (!reader.IsPublisherActive()) {
+            std::cout << "Publisher has shut down" << std::endl;
+            break;
+        }
+
+        // Walk every frame published since the last read (e.g. to feed a
+        // filter); frames older than the history ring are counted as missed
+        if (walkHistory) {
+            uint64_t published = reader.PublishedCount();
+            for (; nextHistoryFrame < published; ++nextHistoryFrame) {
+                if (!reader.ReadHistory(nextHistoryFrame, frame)) {
+                    missed++;
+                }
+            }
+        }
+
+        if (!reader.ReadLatest(frame)) {
+            continue;
+        }
+
+        double latencyMs = (MonotonicNowNs() - frame.sampleTimeNs) / 1e6;
+        std::cout << "[Frame " << frame.frameIndex << "] latency " << std::fixed << std::setprecision(2) << latencyMs << " ms";
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            const HandFrame::Hand& data = frame.hands[hand];
+            std::cout << "  " << HandName(hand) << ": ";
+            if (XR_SUCCEEDED(data.result) && data.isActive) {
+                const XrVector3f& palm = data.joints[XR_HAND_JOINT_PALM_EXT].pose.position;
+                std::cout << std::setprecision(3) << "(" << palm.x << ", " << palm.y << ", " << palm.z << ")";
+            } else {
+                std::cout << "inactive";
+            }
+        }
+        if (walkHistory) {
+            std::cout << "  missed " << missed;
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// What a full ring does with a new item
+enum class OverflowPolicy {
+    DropOldest,  // overwrite the oldest unread item (consumers always see the latest data)
+    DropNewest   // discard the new item (consumers see a gap-free prefix)
+};
+
+inline const char* OverflowPolicyName(OverflowPolicy policy) {
+    return (policy == OverflowPolicy::DropOldest) ? "drop-oldest" : "drop-newest";
+}
+
+// Preallocated lock-free single-producer/single-consumer ring.
+//
+// Push() and Pop() never allocate or block. With DropOldest the producer
+// may reclaim the oldest slot itself; both sides then advance the read
+// index with a CAS, and a consumer whose slot was reclaimed mid-copy
+// discards that copy and retries, so it never returns a torn item.
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing items are copied while racing the producer");
+
+public:
+    SpscRing(size_t capacity, OverflowPolicy policy)
+        : m_policy(policy) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        m_slots.resize(rounded);
+        m_mask = rounded - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side. Returns false if the item itself was dropped.
+    bool Push(const T& item) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+        if (head - tail > m_mask) {
+            if (m_policy == OverflowPolicy::DropNewest) {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+            // Claim the oldest slot unless the consumer takes it first;
+            // either way the slot at head is free afterwards
+            if (m_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        }
+
+        m_slots[head & m_mask] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        m_pushed.store(m_pushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side. Returns false if the ring is empty.
+    bool Pop(T& out) {
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t head = m_head.load(std::memory_order_acquire);
+            if (tail == head) {
+                return false;
+            }
+            out = m_slots[tail & m_mask];
+            if (m_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                m_popped.store(m_popped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return true;
+            }
+            // The producer reclaimed this slot while we were copying it;
+            // tail now holds the new read index
+        }
+    }
+
+    size_t Capacity() const { return m_mask + 1; }
+
+    // Slot storage, e.g. to fault it in before real-time use (read-only)
+    const void* StorageData() const { return m_slots.data(); }
+    size_t StorageBytes() const { return m_slots.size() * sizeof(T); }
+    OverflowPolicy Policy() const { return m_policy; }
+
+    // Approximate number of unread items (exact only from the consumer thread)
+    size_t Size() const {
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        return static_cast<size_t>(head - tail);
+    }
+
+    uint64_t GetPushedCount() const { return m_pushed.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t GetPoppedCount() const { return m_popped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+    OverflowPolicy m_policy;
+
+    // Written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_pushed{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    // Written by the consumer (and by the producer when dropping the oldest item)
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_tail{0};
+    std::atomic<uint64_t> m_popped{0};
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "openxr_minimal.h"
+
+// Base for in-process stand-ins for the runtime's XR_EXT_hand_tracking
+// entry points. The app calls a stand-in through the same
+// PFN_xrCreateHandTrackerEXT / PFN_xrDestroyHandTrackerEXT /
+// PFN_xrLocateHandJointsEXT pointers it would otherwise get from
+// xrGetInstanceProcAddr, so everything downstream of the locate call runs
+// unchanged without gloves, SteamVR or the Manus layer.
+//
+// The stand-in is bound to the trackers through the session handle passed
+// to CreateHandTracker (see SessionHandle()).
+class StandInHandTracker {
+public:
+    virtual ~StandInHandTracker() = default;
+
+    virtual const char* Name() const = 0;
+
+    // Fills locations for the given hand, like xrLocateHandJointsEXT
+    virtual XrResult Locate(XrHandEXT hand, const XrHandJointsLocateInfoEXT* locateInfo,
+                            XrHandJointLocationsEXT* locations) = 0;
+
+    // True once the stand-in has no more data to serve (e.g. end of a replay)
+    virtual bool IsFinished() const { return false; }
+
+    XrSession SessionHandle() {
+        return reinterpret_cast<XrSession>(this);
+    }
+
+    static XrResult XRAPI_CALL CreateHandTracker(XrSession session, const XrHandTrackerCreateInfoEXT* createInfo,
+                                                 XrHandTrackerEXT* handTracker) {
+        if (session == XR_NULL_HANDLE || createInfo == nullptr || handTracker == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->handJointSet != XR_HAND_JOINT_SET_DEFAULT_EXT) {
+            return XR_ERROR_FEATURE_UNSUPPORTED;
+        }
+        Tracker* tracker = new Tracker{reinterpret_cast<StandInHandTracker*>(session), createInfo->hand};
+        *handTracker = reinterpret_cast<XrHandTrackerEXT>(tracker);
+        return XR_SUCCESS;
+    }
+
+    static XrResult XRAPI_CALL DestroyHandTracker(XrHandTrackerEXT handTracker) {
+        delete reinterpret_cast<Tracker*>(handTracker);
+        return XR_SUCCESS;
+    }
+
+    static XrResult XRAPI_CALL LocateHandJoints(XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT* locateInfo,
+                                                XrHandJointLocationsEXT* locations) {
+        if (handTracker == XR_NULL_HANDLE || locations == nullptr || locations->jointLocations == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (locations->jointCount != XR_HAND_JOINT_COUNT_EXT) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        Tracker* tracker = reinterpret_cast<Tracker*>(handTracker);
+        return tracker->owner->Locate(tracker->hand, locateInfo, locations);
+    }
+
+private:
+    struct Tracker {
+        StandInHandTracker* owner;
+        XrHandEXT hand;
+    };
+};
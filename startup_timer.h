@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+// Wall-clock time of each startup phase, plus the time from start until
+// the first frame with a tracked hand. The phases run on the main thread;
+// the first valid frame is marked once from the sampler thread.
+class StartupTimer {
+public:
+    struct Phase {
+        const char* name;
+        int64_t beginNs;
+        int64_t endNs;
+        bool succeeded;
+    };
+
+    StartupTimer() : m_startNs(NowNs()) {}
+
+    static int64_t NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Runs one phase (any callable returning bool) and records its duration
+    template <typename Function>
+    bool Run(const char* name, Function&& phase) {
+        int64_t beginNs = NowNs();
+        bool succeeded = phase();
+        m_phases.push_back({name, beginNs, NowNs(), succeeded});
+        return succeeded;
+    }
+
+    // Sampler thread: the first call wins, later ones are ignored
+    void MarkFirstValidFrame(int64_t sampleTimeNs) {
+        int64_t expected = 0;
+        m_firstValidFrameNs.compare_exchange_strong(expected, sampleTimeNs, std::memory_order_relaxed);
+    }
+
+    bool HasFirstValidFrame() const { return m_firstValidFrameNs.load(std::memory_order_relaxed) != 0; }
+
+    // Milliseconds from start to the first valid frame, or -1 if none yet
+    double FirstValidFrameMs() const {
+        int64_t ns = m_firstValidFrameNs.load(std::memory_order_relaxed);
+        return ns != 0 ? (ns - m_startNs) / 1e6 : -1.0;
+    }
+
+    double ElapsedMs() const { return (NowNs() - m_startNs) / 1e6; }
+    const std::vector<Phase>& GetPhases() const { return m_phases; }
+
+    // One line: each phase and the total so far
+    void Print(std::ostream& out) const {
+        out << "Startup:" << std::fixed << std::setprecision(1);
+        for (const Phase& phase : m_phases) {
+            out << " " << phase.name << " " << (phase.endNs - phase.beginNs) / 1e6 << " ms"
+                << (phase.succeeded ? "," : " (FAILED),");
+        }
+        out << " total " << ElapsedMs() << " ms" << std::defaultfloat << std::endl;
+    }
+
+private:
+    int64_t m_startNs;
+    std::vector<Phase> m_phases;
+    std::atomic<int64_t> m_firstValidFrameNs{0};
+};
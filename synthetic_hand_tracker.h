@@ -0,0 +1,127 @@
+#pragma once
+
+#include "standin_hand_tracker.h"
+#include "pose_math.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+// Procedural hand data for benchmarks and load tests: both hands stay
+// active, the wrists sway slowly and the fingers open and close with
+// per-finger phase offsets. Optional Gaussian position noise mimics sensor
+// jitter. Poses depend only on the sample time, so runs are comparable.
+class SyntheticHandTracker : public StandInHandTracker {
+public:
+    explicit SyntheticHandTracker(float positionNoiseMeters = 0.0005f)
+        : m_noise(positionNoiseMeters) {}
+
+    const char* Name() const override { return "synthetic"; }
+
+    XrResult Locate(XrHandEXT hand, const XrHandJointsLocateInfoEXT* locateInfo,
+                    XrHandJointLocationsEXT* locations) override {
+        double t = SampleSeconds(locateInfo);
+        Generate(hand, t, locations->jointLocations);
+        locations->isActive = XR_TRUE;
+        return XR_SUCCESS;
+    }
+
+    // Fills all XR_HAND_JOINT_COUNT_EXT joints of one hand at time t (seconds)
+    void Generate(XrHandEXT hand, double t, XrHandJointLocationEXT* joints) {
+        const float side = (hand == XR_HAND_LEFT_EXT) ? -1.0f : 1.0f;
+        const float pi = 3.14159265f;
+        const XrVector3f xAxis{1.0f, 0.0f, 0.0f};
+        const XrVector3f yAxis{0.0f, 1.0f, 0.0f};
+
+        XrPosef wrist;
+        wrist.position = {side * 0.15f + 0.02f * static_cast<float>(std::sin(0.7 * t)),
+                          0.05f * static_cast<float>(std::sin(0.5 * t + side)),
+                          -0.30f};
+        wrist.orientation = QuatFromAxisAngle(yAxis, 0.2f * static_cast<float>(std::sin(0.3 * t)));
+
+        const XrSpaceLocationFlags validFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT |
+                                                XR_SPACE_LOCATION_ORIENTATION_VALID_BIT |
+                                                XR_SPACE_LOCATION_POSITION_TRACKED_BIT |
+                                                XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+
+        joints[XR_HAND_JOINT_WRIST_EXT] = {validFlags, wrist, 0.02f};
+
+        // Per finger: first joint, joint count, base offset (x, z), splay, bone lengths
+        struct Finger {
+            int firstJoint;
+            int jointCount;
+            float baseX;
+            float baseZ;
+            float splay;
+            float bones[4];
+        };
+        static const Finger fingers[5] = {
+            {XR_HAND_JOINT_THUMB_METACARPAL_EXT, 4, 0.025f, -0.02f, 0.7f, {0.045f, 0.032f, 0.025f, 0.0f}},
+            {XR_HAND_JOINT_INDEX_METACARPAL_EXT, 5, 0.020f, -0.01f, 0.10f, {0.068f, 0.040f, 0.024f, 0.020f}},
+            {XR_HAND_JOINT_MIDDLE_METACARPAL_EXT, 5, 0.005f, -0.01f, 0.0f, {0.065f, 0.045f, 0.028f, 0.021f}},
+            {XR_HAND_JOINT_RING_METACARPAL_EXT, 5, -0.010f, -0.01f, -0.08f, {0.060f, 0.042f, 0.027f, 0.020f}},
+            {XR_HAND_JOINT_LITTLE_METACARPAL_EXT, 5, -0.024f, -0.01f, -0.18f, {0.055f, 0.033f, 0.020f, 0.019f}},
+        };
+        static const float maxBend[4] = {0.0f, 1.4f, 1.6f, 1.0f};
+
+        for (int f = 0; f < 5; ++f) {
+            const Finger& finger = fingers[f];
+            float curl = 0.5f + 0.5f * static_cast<float>(std::sin(2.0 * pi * 0.4 * t + 0.6 * f + (side > 0 ? 0.0 : 1.5)));
+
+            XrPosef pose;
+            pose.position = {side * finger.baseX, 0.0f, finger.baseZ};
+            pose.orientation = QuatFromAxisAngle(yAxis, side * finger.splay);
+
+            for (int j = 0; j < finger.jointCount; ++j) {
+                XrPosef world = PoseMultiply(wrist, pose);
+                world.position = Add(world.position, NoiseVector());
+                bool tip = (j == finger.jointCount - 1);
+                joints[finger.firstJoint + j] = {validFlags, world, tip ? 0.008f : 0.010f};
+
+                if (!tip) {
+                    // Bend the next bone toward the palm and step along it
+                    float bend = -curl * maxBend[j + (finger.jointCount == 4 ? 1 : 0)];
+                    XrQuaternionf local = QuatFromAxisAngle(xAxis, bend);
+                    pose.orientation = QuatMultiply(pose.orientation, local);
+                    pose.position = Add(pose.position, QuatRotate(pose.orientation, {0.0f, 0.0f, -finger.bones[j]}));
+                }
+            }
+        }
+
+        // Palm: halfway between the wrist and the middle finger's proximal joint
+        XrPosef palm;
+        palm.orientation = wrist.orientation;
+        palm.position = Scale(Add(wrist.position, joints[XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT].pose.position), 0.5f);
+        joints[XR_HAND_JOINT_PALM_EXT] = {validFlags, palm, 0.03f};
+    }
+
+private:
+    float m_noise;
+    uint64_t m_rngState = 0x9E3779B97F4A7C15ull;
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+
+    double SampleSeconds(const XrHandJointsLocateInfoEXT* locateInfo) const {
+        if (locateInfo != nullptr && locateInfo->time > 0) {
+            return locateInfo->time / 1e9;
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    // xorshift64* uniform in [0, 1)
+    float Uniform() {
+        m_rngState ^= m_rngState >> 12;
+        m_rngState ^= m_rngState << 25;
+        m_rngState ^= m_rngState >> 27;
+        return static_cast<float>((m_rngState * 2685821657736338717ull) >> 40) / 16777216.0f;
+    }
+
+    XrVector3f NoiseVector() {
+        if (m_noise <= 0.0f) {
+            return {0.0f, 0.0f, 0.0f};
+        }
+        // Sum of uniforms approximates a Gaussian well enough for jitter
+        auto gaussian = [this]() {
+            return (Uniform() + Uniform() + Uniform() + Uniform() - 2.0f) * 1.7320508f;
+        };
+        return {gaussian() * m_noise, gaussian() * m_noise, gaussian() * m_noise};
+    }
+};
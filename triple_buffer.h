@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer "latest value" buffer.
+//
+// The producer fills WriteBuffer() in place and Publish()es it; the
+// consumer's ReadLatest() returns a pointer to the newest published value.
+// Neither side copies or blocks: three slots rotate between the writer,
+// the reader and the one in between, and each side only swaps its own slot
+// with the middle one. A value the reader holds stays untouched until its
+// next ReadLatest(). Values the reader never got to are skipped, not queued.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side: the slot to fill for the next Publish()
+    T& WriteBuffer() { return m_slots[m_back].value; }
+
+    // Producer side: makes the filled slot the latest value
+    void Publish() {
+        uint32_t previous = m_middle.exchange(m_back | FRESH_BIT, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+        m_published.store(m_published.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Consumer side: the newest published value, or nullptr before the
+    // first Publish(). Valid until the next ReadLatest().
+    const T* ReadLatest() {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH_BIT) {
+            uint32_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & INDEX_MASK;
+            m_hasValue = true;
+        }
+        return m_hasValue ? &m_slots[m_front].value : nullptr;
+    }
+
+    uint64_t GetPublishedCount() const { return m_published.load(std::memory_order_relaxed); }
+
+    // Slot storage, e.g. to fault it in before real-time use (read-only)
+    const void* StorageData() const { return m_slots; }
+    size_t StorageBytes() const { return sizeof(m_slots); }
+
+private:
+    static constexpr uint32_t INDEX_MASK = 0x3;
+    static constexpr uint32_t FRESH_BIT = 0x4;  // the middle slot has not been read yet
+
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot m_slots[3];
+    alignas(64) std::atomic<uint32_t> m_middle{1};
+    alignas(64) uint32_t m_back = 0;     // producer
+    std::atomic<uint64_t> m_published{0};
+    alignas(64) uint32_t m_front = 2;    // consumer
+    bool m_hasValue = false;
+};
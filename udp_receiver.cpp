@@ -0,0 +1,159 @@
+#include "udp_stream.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <csignal>
+#include <chrono>
+#include <atomic>
+
+// ============================================================================
+// UDP stream receiver
+// ============================================================================
+// Receives the packets sent by test_handtracking_only --stream <host:port>,
+// decodes them back into frames and prints both palms twice a second with
+// packet statistics (bytes per frame, lost and undecodable packets).
+// Gesture events (--gesture-events <host:port>) may arrive on the same
+// port; each one is printed as soon as it arrives, with the time from the
+// sample that confirmed it to its arrival.
+// ============================================================================
+
+static std::atomic<bool> g_stopRequested{false};
+
+static void HandleStopSignal(int) {
+    g_stopRequested.store(true);
+}
+
+void PrintUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --port <n>          UDP port to listen on (default " << DEFAULT_STREAM_PORT << ")" << std::endl;
+    std::cout << "  --bind <address>    Local address to bind (default 0.0.0.0)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = DEFAULT_STREAM_PORT;
+    std::string bindAddress = "0.0.0.0";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) {
+            char* end = nullptr;
+            long value = std::strtol(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || value <= 0 || value > 65535) {
+                std::cerr << "Invalid port: " << argv[i] << std::endl;
+                return -1;
+            }
+            port = static_cast<uint16_t>(value);
+        } else if (arg == "--bind" && hasValue) {
+            bindAddress = argv[++i];
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    UdpStreamReceiver receiver;
+    if (!receiver.Open(port, bindAddress)) {
+        return -1;
+    }
+    std::cout << "Listening for hand frames and gesture events on " << bindAddress << ":" << port << std::endl;
+
+    HandStreamDecoder decoder;
+    HandFrame frame;
+    uint8_t packet[STREAM_MAX_PACKET_SIZE];
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t decoded = 0;
+    uint64_t lost = 0;
+    uint64_t malformed = 0;
+    uint64_t missingKeyframe = 0;
+    bool haveLastIndex = false;
+    uint32_t lastIndex = 0;
+    GestureEvent event;
+    uint64_t events = 0;
+    uint64_t lostEvents = 0;
+    uint32_t nextSequence = 0;
+    auto nextPrint = std::chrono::steady_clock::now();
+
+    while (!g_stopRequested.load()) {
+        int size = receiver.Receive(packet, sizeof(packet), 100);
+        if (size < 0) {
+            std::cerr << "Receive failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (size == 0) {
+            continue;
+        }
+
+        if (IsGestureEventPacket(packet, static_cast<size_t>(size))) {
+            if (!DecodeGestureEvent(packet, static_cast<size_t>(size), event)) {
+                malformed++;
+                continue;
+            }
+            if (events > 0 && event.sequence > nextSequence) {
+                lostEvents += event.sequence - nextSequence;
+            }
+            events++;
+            nextSequence = event.sequence + 1;
+            // Sender and receiver share CLOCK_MONOTONIC only on the same
+            // machine; elsewhere the arrival time is meaningless
+            int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::cout << "[Event " << event.sequence << "] [Frame " << event.frameIndex << "] " << HandName(event.hand)
+                      << " " << GestureTypeName(event.type) << std::fixed << std::setprecision(3) << " value " << event.value
+                      << " at (" << event.position.x << ", " << event.position.y << ", " << event.position.z << ")"
+                      << std::setprecision(1) << ", debounced " << (event.sampleTimeNs - event.onsetTimeNs) / 1e6
+                      << " ms, arrived " << (nowNs - event.sampleTimeNs) / 1e6 << " ms after the sample"
+                      << ", " << lostEvents << " events lost" << std::defaultfloat << std::endl;
+            continue;
+        }
+        packets++;
+        bytes += static_cast<uint64_t>(size);
+
+        StreamDecodeResult result = decoder.Decode(packet, static_cast<size_t>(size), frame);
+        if (result == StreamDecodeResult::Malformed) {
+            malformed++;
+            continue;
+        }
+        // Gaps in the frame index are packets lost on the way (the sender
+        // numbers every frame, including ones its ring dropped)
+        uint32_t index = static_cast<uint32_t>(frame.frameIndex);
+        if (haveLastIndex && index > lastIndex + 1) {
+            lost += index - lastIndex - 1;
+        }
+        haveLastIndex = true;
+        lastIndex = index;
+        if (result == StreamDecodeResult::MissingKeyframe) {
+            missingKeyframe++;
+            continue;
+        }
+        decoded++;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextPrint) {
+            continue;
+        }
+        nextPrint = now + std::chrono::milliseconds(500);
+
+        std::cout << "[Frame " << frame.frameIndex << "]" << std::fixed << std::setprecision(3);
+        for (int hand = 0; hand < HAND_COUNT; ++hand) {
+            const HandFrame::Hand& data = frame.hands[hand];
+            std::cout << "  " << HandName(hand) << ": ";
+            if (XR_SUCCEEDED(data.result) && data.isActive) {
+                const XrVector3f& palm = data.joints[XR_HAND_JOINT_PALM_EXT].pose.position;
+                std::cout << "(" << palm.x << ", " << palm.y << ", " << palm.z << ")";
+            } else {
+                std::cout << "inactive";
+            }
+        }
+        std::cout << std::setprecision(1) << "  | " << static_cast<double>(bytes) / packets << " bytes/frame, "
+                  << decoded << " decoded, " << lost << " lost, " << missingKeyframe << " waiting for keyframe, "
+                  << malformed << " malformed" << std::defaultfloat << std::endl;
+    }
+
+    return 0;
+}
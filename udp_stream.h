@@ -0,0 +1,222 @@
+#pragma once
+
+#include "hand_stream_codec.h"
+#include "gesture_event.h"
+#include "net_address.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// Splits "host:port" or "[host]:port" (port defaults to DEFAULT_STREAM_PORT)
+inline bool ParseStreamAddress(const std::string& address, std::string& host, std::string& port) {
+    port = std::to_string(DEFAULT_STREAM_PORT);
+    return SplitHostPort(address, host, port);
+}
+
+// Resolves "host:port" and creates a datagram socket for it. Returns the
+// socket, or -1 after printing why; what names the destination in messages.
+inline int OpenUdpDestination(const std::string& destination, const char* what,
+                              sockaddr_storage& address, socklen_t& addressLength) {
+    std::string host;
+    std::string port;
+    if (!ParseStreamAddress(destination, host, port)) {
+        std::cerr << "Invalid " << what << " destination: " << destination << " (expected host:port or [host]:port)" << std::endl;
+        return -1;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* addresses = nullptr;
+    int error = getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses);
+    if (error != 0) {
+        std::cerr << "Failed to resolve " << what << " destination " << destination << ": " << gai_strerror(error) << std::endl;
+        return -1;
+    }
+    int fd = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+    if (fd >= 0) {
+        std::memcpy(&address, addresses->ai_addr, addresses->ai_addrlen);
+        addressLength = addresses->ai_addrlen;
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        std::cerr << "Failed to create " << what << " socket: " << std::strerror(errno) << std::endl;
+    }
+    return fd;
+}
+
+// Sends one encoded packet per frame to a UDP destination. Send() runs on
+// a frame consumer thread, never on the sampler.
+class UdpStreamSender {
+public:
+    ~UdpStreamSender() {
+        Close();
+    }
+
+    bool Open(const std::string& destination, uint32_t keyframeInterval) {
+        m_socket = OpenUdpDestination(destination, "stream", m_destination, m_destinationLength);
+        if (m_socket < 0) {
+            return false;
+        }
+
+        m_encoder = HandStreamEncoder(keyframeInterval);
+        m_destinationName = destination;
+        return true;
+    }
+
+    void Send(const HandFrame& frame) {
+        size_t size = m_encoder.Encode(frame, m_packet, sizeof(m_packet));
+        if (size == 0) {
+            m_sendErrors++;
+            return;
+        }
+        ssize_t sent = sendto(m_socket, m_packet, size, 0, reinterpret_cast<const sockaddr*>(&m_destination), m_destinationLength);
+        if (sent < 0) {
+            m_sendErrors++;
+            return;
+        }
+        m_packetsSent++;
+        m_bytesSent += static_cast<uint64_t>(sent);
+    }
+
+    void Close() {
+        if (m_socket >= 0) {
+            ::close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    const std::string& GetDestination() const { return m_destinationName; }
+    uint64_t GetPacketsSent() const { return m_packetsSent.load(std::memory_order_relaxed); }
+    uint64_t GetBytesSent() const { return m_bytesSent.load(std::memory_order_relaxed); }
+    uint64_t GetSendErrors() const { return m_sendErrors.load(std::memory_order_relaxed); }
+
+private:
+    int m_socket = -1;
+    sockaddr_storage m_destination{};
+    socklen_t m_destinationLength = 0;
+    std::string m_destinationName;
+    HandStreamEncoder m_encoder;
+    uint8_t m_packet[STREAM_MAX_PACKET_SIZE];
+
+    // Written by the consumer thread, read by the status line
+    std::atomic<uint64_t> m_packetsSent{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+    std::atomic<uint64_t> m_sendErrors{0};
+};
+
+// Sends one datagram per gesture event (gesture_event.h). Events are rare
+// and tiny, so there is no batching; Send() runs on its own consumer
+// thread like UdpStreamSender.
+class UdpEventSender {
+public:
+    ~UdpEventSender() {
+        Close();
+    }
+
+    bool Open(const std::string& destination) {
+        m_socket = OpenUdpDestination(destination, "gesture event", m_destination, m_destinationLength);
+        if (m_socket < 0) {
+            return false;
+        }
+        m_destinationName = destination;
+        return true;
+    }
+
+    void Send(const GestureEvent& event) {
+        uint8_t packet[GESTURE_EVENT_PACKET_SIZE];
+        size_t size = EncodeGestureEvent(event, packet, sizeof(packet));
+        ssize_t sent = size == 0 ? -1 : sendto(m_socket, packet, size, 0, reinterpret_cast<const sockaddr*>(&m_destination), m_destinationLength);
+        if (sent < 0) {
+            m_sendErrors++;
+            return;
+        }
+        m_eventsSent++;
+    }
+
+    void Close() {
+        if (m_socket >= 0) {
+            ::close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    const std::string& GetDestination() const { return m_destinationName; }
+    uint64_t GetEventsSent() const { return m_eventsSent.load(std::memory_order_relaxed); }
+    uint64_t GetSendErrors() const { return m_sendErrors.load(std::memory_order_relaxed); }
+
+private:
+    int m_socket = -1;
+    sockaddr_storage m_destination{};
+    socklen_t m_destinationLength = 0;
+    std::string m_destinationName;
+
+    // Written by the consumer thread, read by the status line
+    std::atomic<uint64_t> m_eventsSent{0};
+    std::atomic<uint64_t> m_sendErrors{0};
+};
+
+// Receives stream packets on a UDP port
+class UdpStreamReceiver {
+public:
+    ~UdpStreamReceiver() {
+        Close();
+    }
+
+    bool Open(uint16_t port, const std::string& bindAddress = "0.0.0.0") {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* addresses = nullptr;
+        std::string service = std::to_string(port);
+        int error = getaddrinfo(bindAddress.c_str(), service.c_str(), &hints, &addresses);
+        if (error != 0) {
+            std::cerr << "Failed to resolve " << bindAddress << ": " << gai_strerror(error) << std::endl;
+            return false;
+        }
+        m_socket = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+        bool bound = m_socket >= 0 && bind(m_socket, addresses->ai_addr, addresses->ai_addrlen) == 0;
+        freeaddrinfo(addresses);
+        if (!bound) {
+            std::cerr << "Failed to bind UDP port " << port << ": " << std::strerror(errno) << std::endl;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    // Waits up to timeoutMs for one packet. Returns its size, 0 on timeout
+    // and -1 on error.
+    int Receive(uint8_t* buffer, size_t capacity, int timeoutMs) {
+        pollfd descriptor{m_socket, POLLIN, 0};
+        int ready = poll(&descriptor, 1, timeoutMs);
+        if (ready <= 0) {
+            return ready < 0 && errno != EINTR ? -1 : 0;
+        }
+        ssize_t received = recv(m_socket, buffer, capacity, 0);
+        if (received < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+        return static_cast<int>(received);
+    }
+
+    void Close() {
+        if (m_socket >= 0) {
+            ::close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    int NativeHandle() const { return m_socket; }
+
+private:
+    int m_socket = -1;
+};
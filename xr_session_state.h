@@ -0,0 +1,29 @@
+#pragma once
+
+#include "openxr_minimal.h"
+
+// Session lifecycle as the app drives it (hand_tracking_app.h):
+//
+//   IDLE -> READY          xrBeginSession, start the sampler
+//   SYNCHRONIZED/VISIBLE/FOCUSED   running, sampling
+//   STOPPING               stop the sampler, xrEndSession
+//   LOSS_PENDING           stop the sampler, destroy the trackers, space
+//                          and session, then recreate them with backoff
+//   EXITING                the runtime wants the app to end
+//
+// The sampler only exists while the session is running, so an idle or
+// lost session costs no locate calls and no CPU.
+
+inline const char* SessionStateName(XrSessionState state) {
+    switch (state) {
+        case XR_SESSION_STATE_IDLE: return "IDLE";
+        case XR_SESSION_STATE_READY: return "READY";
+        case XR_SESSION_STATE_SYNCHRONIZED: return "SYNCHRONIZED";
+        case XR_SESSION_STATE_VISIBLE: return "VISIBLE";
+        case XR_SESSION_STATE_FOCUSED: return "FOCUSED";
+        case XR_SESSION_STATE_STOPPING: return "STOPPING";
+        case XR_SESSION_STATE_LOSS_PENDING: return "LOSS_PENDING";
+        case XR_SESSION_STATE_EXITING: return "EXITING";
+        default: return "UNKNOWN";
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "openxr_minimal.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <time.h>
+
+// Converts between the monotonic clock (std::chrono::steady_clock, i.e.
+// CLOCK_MONOTONIC, used for all sample timestamps in this app) and the
+// runtime's XrTime.
+//
+// With XR_KHR_convert_timespec_time the runtime defines the mapping. Calling
+// it for every sample would mean a round trip through the loader and API
+// layers, so the offset between the two clocks is measured once and then
+// re-measured with Calibrate() every few seconds. Calibrate() may run on
+// another thread than the conversions: the offset is a single atomic, so
+// the sampler never makes the runtime call itself. Without the extension
+// (or for the stand-in sources), XrTime is taken to be CLOCK_MONOTONIC in
+// nanoseconds. This matches common Linux runtimes, but it is only an
+// approximation.
+class XrTimeSource {
+public:
+    // Call after instance creation. extensionEnabled tells whether
+    // XR_KHR_convert_timespec_time was enabled on the instance.
+    void Initialize(XrInstance instance, bool extensionEnabled) {
+        m_instance = instance;
+        m_toXrTime = nullptr;
+        m_fromXrTime = nullptr;
+        m_offsetNs.store(0, std::memory_order_relaxed);
+        if (instance == XR_NULL_HANDLE || !extensionEnabled) {
+            return;
+        }
+        if (XR_FAILED(xrGetInstanceProcAddr(instance, "xrConvertTimespecTimeToTimeKHR",
+                                            reinterpret_cast<PFN_xrVoidFunction*>(&m_toXrTime))) ||
+            XR_FAILED(xrGetInstanceProcAddr(instance, "xrConvertTimeToTimespecTimeKHR",
+                                            reinterpret_cast<PFN_xrVoidFunction*>(&m_fromXrTime)))) {
+            std::cout << "Warning: XR_KHR_convert_timespec_time functions not available - assuming XrTime is CLOCK_MONOTONIC" << std::endl;
+            m_toXrTime = nullptr;
+            m_fromXrTime = nullptr;
+            return;
+        }
+        Calibrate();
+    }
+
+    // True if XrTime comes from the runtime rather than the monotonic fallback
+    bool IsRuntimeClock() const { return m_toXrTime != nullptr; }
+
+    // Re-measures the clock offset. Cheap but not free (one runtime call);
+    // run every few seconds, not every sample.
+    void Calibrate() {
+        if (m_toXrTime == nullptr) {
+            return;
+        }
+        int64_t monotonicNs = NowNs();
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(monotonicNs / 1000000000);
+        ts.tv_nsec = static_cast<long>(monotonicNs % 1000000000);
+        XrTime xrTime = 0;
+        if (XR_SUCCEEDED(m_toXrTime(m_instance, &ts, &xrTime))) {
+            m_offsetNs.store(xrTime - monotonicNs, std::memory_order_relaxed);
+        }
+    }
+
+    XrTime ToXrTime(int64_t monotonicNs) const {
+        return monotonicNs + m_offsetNs.load(std::memory_order_relaxed);
+    }
+
+    int64_t ToMonotonicNs(XrTime time) const {
+        return time - m_offsetNs.load(std::memory_order_relaxed);
+    }
+
+    int64_t OffsetNs() const { return m_offsetNs.load(std::memory_order_relaxed); }
+
+    static int64_t NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    XrInstance m_instance = XR_NULL_HANDLE;
+    PFN_xrConvertTimespecTimeToTimeKHR m_toXrTime = nullptr;
+    PFN_xrConvertTimeToTimespecTimeKHR m_fromXrTime = nullptr;
+    std::atomic<int64_t> m_offsetNs{0};  // XrTime - CLOCK_MONOTONIC ns
+};